@@ -10,6 +10,7 @@ target_link_libraries(
   compute::components
   fmt::fmt
   utils::logger
+  utils::profile
 )
 
 append_clang_tidy_check(TARGET demo_application CHECK "gfx-fundamental-type")
@@ -17,7 +18,10 @@ append_clang_tidy_check(TARGET demo_application CHECK "gfx-fundamental-type")
 gfx_executable_target(
   TARGET demo-application
   MAIN gfx/applications/demo_application_main.cpp
-  DEPENDENCIES demo_application
+  DEPENDENCIES
+    demo_application
+    utils::arg_parser
+    utils::trace
 )
 
 append_clang_tidy_check(TARGET demo-application CHECK "gfx-fundamental-type")
@@ -42,6 +46,8 @@ target_link_libraries(
   ffmpeg::libswscale
   fmt::fmt
   utils::arg_parser
+  utils::profile
+  utils::trace
   vocabulary
 )
 
@@ -56,6 +62,43 @@ target_link_libraries(
   vocabulary::uri
 )
 
+gfx_executable_target(
+  TARGET demux-shmem
+  MAIN gfx/applications/demux_shmem_main.cpp
+  DEPENDENCIES
+    utils::video_demuxer
+    utils::arg_parser
+    utils::logger
+    utils::trace
+    system_resources::shmem_writer
+    fmt::fmt
+)
+
+gfx_executable_target(
+  TARGET thumbnails
+  MAIN gfx/applications/thumbnails_main.cpp
+  DEPENDENCIES
+    utils::video_demuxer
+    utils::arg_parser
+    utils::image_sink
+    utils::logger
+    fmt::fmt
+)
+
+gfx_executable_target(
+  TARGET batch-transcode
+  MAIN gfx/applications/batch_transcode_main.cpp
+  DEPENDENCIES
+    dummy_video_muxer
+    utils::video_demuxer
+    utils::thread_pool
+    utils::arg_parser
+    utils::logger
+    utils::trace
+    vocabulary::uri
+    fmt::fmt
+)
+
 add_library(dummy_texture STATIC)
 target_sources(
   dummy_texture
@@ -0,0 +1,186 @@
+#include "utils/arg_parser.hpp"
+#include "utils/demuxer.hpp"
+#include "utils/frame.hpp"
+#include "utils/logger.hpp"
+#include "utils/muxer.hpp"
+#include "utils/thread_pool.hpp"
+#include "utils/trace.hpp"
+#include "vocabulary/uri.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using Clock   = std::chrono::steady_clock;
+using Seconds = std::chrono::duration<double>;
+
+struct Result
+{
+    std::filesystem::path input{};
+    int64_t frames{0};
+    Seconds latency{};
+    bool success{false};
+};
+
+// Every file in flight runs one decoder and one encoder, split the cores between them
+struct ThreadBudget
+{
+    size_t workers{};
+    int codecThreads{};
+};
+
+ThreadBudget get_thread_budget(size_t numInputs)
+{
+  const size_t cores = std::max(std::thread::hardware_concurrency(), 1U);
+
+  // A decoder and an encoder thread at least per worker, within the cores
+  const size_t maxWorkers = std::max<size_t>(cores / 2, 1);
+  const size_t workers    = std::clamp<size_t>(numInputs, 1, maxWorkers);
+
+  const size_t codecThreads = std::max<size_t>(cores / (workers * 2), 1);
+  return ThreadBudget{workers, static_cast<int>(codecThreads)};
+}
+
+std::vector<std::filesystem::path> list_inputs(const std::filesystem::path& directory)
+{
+  std::vector<std::filesystem::path> inputs{};
+  for (const auto& entry : std::filesystem::directory_iterator{directory})
+  {
+    if (entry.is_regular_file())
+    {
+      inputs.push_back(entry.path());
+    }
+  }
+  std::ranges::sort(inputs);
+  return inputs;
+}
+
+Result transcode(const std::filesystem::path& input,
+                 const std::filesystem::path& outputDirectory,
+                 int threads)
+{
+  Result result{.input = input};
+  const auto start = Clock::now();
+
+  std::filesystem::path output = outputDirectory / input.filename();
+  output.replace_extension(".mp4");
+
+  const std::string inputUri  = "file:" + input.string();
+  const std::string outputUri = "file:" + output.string();
+
+  {
+    gfx::utils::video::Demuxer demuxer{gfx::URI{inputUri}, threads};
+    gfx::utils::video::Muxer muxer{gfx::URI{outputUri},
+                                   demuxer.size(),
+                                   demuxer.frameRate(),
+                                   threads};
+
+    bool written{true};
+    const bool decoded = demuxer.decode([&](const gfx::utils::video::Frame& frame) {
+      written = muxer.write(frame);
+      result.frames += written ? 1 : 0;
+      return written;
+    });
+    result.success = decoded && written;
+  }
+
+  result.latency = Clock::now() - start;
+  return result;
+}
+
+bool report(const std::vector<Result>& results, Seconds elapsed)
+{
+  int64_t totalFrames{0};
+  bool success{true};
+
+  for (const auto& result : results)
+  {
+    totalFrames += result.frames;
+    success = success && result.success;
+
+    const double seconds = std::max(result.latency.count(), 1e-9);
+    gfx::utils::logger::info("{}: {} frames in {:.3f} s ({:.1f} fps){}",
+                             result.input.filename().string(),
+                             result.frames,
+                             result.latency.count(),
+                             static_cast<double>(result.frames) / seconds,
+                             result.success ? "" : " FAILED");
+  }
+
+  gfx::utils::logger::info("{} files, {} frames in {:.3f} s, aggregate {:.1f} fps",
+                           results.size(),
+                           totalFrames,
+                           elapsed.count(),
+                           static_cast<double>(totalFrames)
+                               / std::max(elapsed.count(), 1e-9));
+
+  return success;
+}
+} // namespace
+
+// Re-encode every file in '--input-path' into '--output-path' as H264
+int main(int argc, const char* const* argv)
+{
+  using namespace gfx;
+
+  try
+  {
+    const utils::ArgParser argParser{argc, argv};
+
+    // Declared before the pool, its workers stop recording before the trace closes
+    const utils::trace::Session trace{argParser.getTracePath()};
+
+    const std::filesystem::path outputDirectory = argParser.getOutputPath();
+    std::filesystem::create_directories(outputDirectory);
+
+    const auto inputs = list_inputs(argParser.getInputPath());
+    const auto budget = get_thread_budget(inputs.size());
+
+    utils::logger::info("transcoding {} files on {} workers, {} threads "
+                        "per decoder and encoder",
+                        inputs.size(),
+                        budget.workers,
+                        budget.codecThreads);
+
+    std::vector<Result> results(inputs.size());
+    const auto start = Clock::now();
+
+    {
+      utils::ThreadPool pool{budget.workers};
+      for (size_t index = 0; index < inputs.size(); ++index)
+      {
+        pool.submit([&, index] {
+          try
+          {
+            results[index] = transcode(inputs[index],
+                                       outputDirectory,
+                                       budget.codecThreads);
+          }
+          catch (const std::exception& e)
+          {
+            results[index].input = inputs[index];
+            utils::logger::error("{}", e.what());
+          }
+        });
+      }
+      pool.wait();
+    }
+
+    return report(results, Clock::now() - start) ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  catch (const std::exception& e)
+  {
+    std::puts(e.what());
+    return EXIT_FAILURE;
+  }
+}
@@ -4,18 +4,22 @@
 #include "compute/context.hpp"
 #include "compute/pixel_buffer.hpp"
 #include "compute/utils/compute_dump.hpp"
+#include "graphics/gpu_profile.hpp"
+#include "graphics/program_cache.hpp"
 #include "graphics/quad.hpp"
 #include "graphics/shader.hpp"
 #include "graphics/texture.hpp"
-#include "graphics/utils/graphics_dump.hpp"
+#include "graphics/utils/texture_readback.hpp"
 #include "graphics/window.hpp"
 #include "shaders/texture.hpp"
+#include "utils/profile.hpp"
 #include "utils/timestamp.hpp"
 #include "vocabulary/color.hpp"
 #include "vocabulary/size.hpp"
 
 #include <cudaGL.h>
 
+#include <chrono>
 #include <string>
 
 namespace gfx
@@ -26,10 +30,14 @@ void DemoApplication::run()
   constexpr gfx::Size windowSize{1200, 800};
   graphics::Window window{"demo application", windowSize};
 
+  graphics::program_cache::enable();
+
   const graphics::Quad quad{};
   const graphics::Shader shader(graphics::shaders::Texture::vertex,
                                 graphics::shaders::Texture::fragment);
 
+  graphics::program_cache::log_stats();
+
   shader.use();
   // NOLINTNEXTLINE(gfx-fundamental-type)
   const float scale{0.8F};
@@ -55,10 +63,9 @@ void DemoApplication::run()
 
   auto timestamp = utils::getTimestamp();
 
-  utils::dump_texture(timestamp + "_dump_texture.jpg",
-                      texture.get(),
-                      drawSize.width,
-                      drawSize.height);
+  // Encoded off the render thread, written at the latest when the run ends
+  utils::TextureReadback readback{drawSize};
+  readback.dump(timestamp + "_dump_texture.jpg", texture.get());
 
   compute::utils::dump_deviceptr(timestamp + "_dump_deviceptr.jpg",
                                  devicePtr,
@@ -66,10 +73,17 @@ void DemoApplication::run()
 
   texture.bind();
 
+  utils::profile::enable_summary();
+  window.reportFrameStats(std::chrono::seconds{5}); // NOLINT
+
   while (window.isOpen())
   {
     quad.draw();
     window.swap();
   }
+
+  utils::profile::disable_summary();
+  graphics::gpu_profile::collect(true);
+  utils::profile::log_summary();
 }
 } // namespace gfx
@@ -1,9 +1,14 @@
 #include "demo_application.hpp"
+#include "utils/arg_parser.hpp"
+#include "utils/trace.hpp"
 
 #include <cstdlib>
 
-int main()
+int main(int argc, const char* const* argv)
 {
+  const gfx::utils::ArgParser argParser{argc, argv};
+  const gfx::utils::trace::Session trace{argParser.getTracePath()};
+
   gfx::DemoApplication::run();
   return EXIT_SUCCESS;
 }
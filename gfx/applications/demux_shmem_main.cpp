@@ -0,0 +1,68 @@
+#include "shmem/writer.hpp"
+#include "utils/arg_parser.hpp"
+#include "utils/demuxer.hpp"
+#include "utils/logger.hpp"
+#include "utils/trace.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string>
+
+// Decode a video file or live stream and publish every frame into a shmem channel
+int main(int argc, const char* const* argv)
+{
+  using namespace gfx;
+
+  try
+  {
+    const utils::ArgParser argParser{argc, argv};
+    const utils::trace::Session trace{argParser.getTracePath()};
+    const std::string channel = argParser.getShmemName();
+
+    utils::video::Demuxer demuxer{argParser.getInputUri()};
+
+    // Readers upload straight into RGBA textures, convert here off the render thread.
+    // The channel size is fixed, later resolution changes are scaled to fit.
+    demuxer.setOutput(utils::video::OutputFormat::RGBA, demuxer.size());
+
+    if (argParser.getVerbose())
+    {
+      demuxer.dumpFormat();
+    }
+
+    shmem::Writer writer{channel.c_str(), demuxer.frameBufferSize()};
+
+    utils::logger::info("publishing {}x{} RGBA frames ({} bytes) to '{}'",
+                        static_cast<int>(demuxer.outputSize().width),
+                        static_cast<int>(demuxer.outputSize().height),
+                        demuxer.frameBufferSize(),
+                        channel);
+
+    const auto start = std::chrono::steady_clock::now();
+    int64_t published{0};
+
+    const bool success = demuxer.decode([&](const utils::video::Frame& frame) {
+      writer.write(frame.data.data());
+      published = frame.index + 1;
+      return true;
+    });
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now()
+                                                - start;
+
+    utils::logger::info("published {} frames in {:.2f} s ({:.1f} fps)",
+                        published,
+                        elapsed.count(),
+                        static_cast<double>(published) / elapsed.count());
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  catch (const std::exception& e)
+  {
+    std::puts(e.what());
+    return EXIT_FAILURE;
+  }
+}
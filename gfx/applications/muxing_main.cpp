@@ -11,10 +11,13 @@ int main(int argc, const char* const* argv)
   try
   {
     const gfx::utils::ArgParser argParser{argc, argv};
-    gfx::utils::video::Muxer{argParser.getOutputUri(),
-                             argParser.getSize(),
-                             gfx::time::as_ms(argParser.getDuration()),
-                             argParser.getFrameRate()};
+    gfx::utils::video::Muxer muxer{argParser.getOutputUri(),
+                                   argParser.getSize(),
+                                   argParser.getFrameRate()};
+    if (!muxer.writeTestPattern(gfx::time::as_ms(argParser.getDuration())))
+    {
+      return EXIT_FAILURE;
+    }
   }
   catch (const std::exception& e)
   {
@@ -1,14 +1,19 @@
 #include "applications/dummy_texture.hpp"
-#include "graphics/shader.hpp"
+#include "graphics/gpu_profile.hpp"
 #include "graphics/texture.hpp"
 #include "graphics/utils/graphics_dump.hpp"
 #include "graphics/window.hpp"
-#include "shaders/yuv.hpp"
+#include "graphics/yuv_converter.hpp"
+#include "utils/logger.hpp"
+#include "utils/profile.hpp"
 #include "vocabulary/size.hpp"
 
 #include <GL/glew.h>
 
+#include <cstdint>
 #include <cstdlib>
+#include <fstream>
+#include <vector>
 
 int main()
 {
@@ -16,28 +21,31 @@ int main()
 
   const graphics::Window window{"opengl_compute_shader",
                                 dummy_texture::size,
-                                graphics::Window::Mode::Headless};
+                                graphics::Window::Mode::Offscreen};
 
   const graphics::Texture inputTexture{dummy_texture::size,
                                        dummy_texture::get().data()};
-  const graphics::Texture outputTexture{dummy_texture::size};
 
-  const graphics::Shader shader{graphics::shaders::Yuv::compute};
+  const graphics::YuvConverter converter{dummy_texture::size};
+  converter.convert(inputTexture.get());
 
-  shader.use();
+  std::vector<uint8_t> frame(converter.frameSize());
+  converter.read(frame);
 
-  glBindImageTexture(0, inputTexture.get(), 0, GL_FALSE, 0, GL_READ_ONLY, GL_RGBA8);
-  glBindImageTexture(1, outputTexture.get(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+  // CPU submission and GPU execution of the conversion
+  graphics::gpu_profile::collect(true);
+  utils::profile::log_summary();
 
-  glDispatchCompute(dummy_texture::size.width, dummy_texture::size.height, 1);
+  // Raw I420, e.g. ffplay -f rawvideo -pixel_format yuv420p -video_size 512x512
+  std::ofstream output{"output.yuv", std::ios::binary};
+  output.write(reinterpret_cast<const char*>(frame.data()), // NOLINT
+               static_cast<std::streamsize>(frame.size()));
+  if (!output)
+  {
+    utils::logger::error("opengl_compute_shader - could not write output.yuv");
+    return EXIT_FAILURE;
+  }
 
-  glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-
-  glActiveTexture(GL_TEXTURE1);
-  utils::dump_texture("output.jpg",
-                      outputTexture.get(),
-                      dummy_texture::size.width,
-                      dummy_texture::size.height);
   glActiveTexture(GL_TEXTURE0);
   utils::dump_texture("input.jpg",
                       inputTexture.get(),
@@ -1,6 +1,8 @@
 #include "compute/circle_texture.cuh"
 #include "compute/context.hpp"
 #include "compute/texture_buffer.hpp"
+#include "graphics/pixel_format.hpp"
+#include "graphics/program_cache.hpp"
 #include "graphics/quad.hpp"
 #include "graphics/shader.hpp"
 #include "graphics/window.hpp"
@@ -10,6 +12,7 @@
 
 #include <GL/glew.h>
 
+#include <chrono>
 #include <cstdlib>
 
 int main(int argc, char** argv)
@@ -22,12 +25,19 @@ int main(int argc, char** argv)
   compute::Context const context{};
 
   constexpr gfx::Size surfaceSize{512, 512};
-  compute::TextureBuffer textureBuffer{surfaceSize};
+  compute::TextureBuffer textureBuffer{surfaceSize, graphics::PixelFormat::RGBA8};
+
+  graphics::program_cache::enable();
 
   graphics::Quad const quad{};
   graphics::Shader const shader(graphics::shaders::Texture::vertex,
                                 graphics::shaders::Texture::fragment);
 
+  if (argParser.getVerbose())
+  {
+    graphics::program_cache::log_stats();
+  }
+
   shader.use();
   const float scale = 0.8F;
   shader.setMatrixUniform(scale);
@@ -40,6 +50,11 @@ int main(int argc, char** argv)
 
   glBindTexture(GL_TEXTURE_2D, textureBuffer.getTexture());
 
+  if (argParser.getVerbose())
+  {
+    window.reportFrameStats(std::chrono::seconds{5}); // NOLINT
+  }
+
   // NOLINTNEXTLINE(cppcoreguidelines-avoid-do-while)
   do
   {
@@ -0,0 +1,96 @@
+#include "utils/arg_parser.hpp"
+#include "utils/demuxer.hpp"
+#include "utils/frame.hpp"
+#include "utils/image_sink.hpp"
+#include "utils/logger.hpp"
+#include "vocabulary/size.hpp"
+#include "vocabulary/time.hpp"
+
+#include <fmt/core.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <string>
+
+namespace
+{
+constexpr size_t channels{4};
+constexpr int jpegQuality{90};
+
+// 'pattern' is e.g. 'thumbs/clip.jpg', frames are written as 'thumbs/clip_001500.jpg'
+bool write_thumbnail(const std::filesystem::path& pattern,
+                     const gfx::utils::video::Frame& frame)
+{
+  std::filesystem::path path = pattern;
+  path.replace_filename(fmt::format("{}_{:06}{}",
+                                    pattern.stem().string(),
+                                    frame.timestamp.count(),
+                                    pattern.extension().string()));
+
+  return gfx::utils::image::write(path.string(),
+                                  {frame.data, frame.size, channels},
+                                  {.quality = jpegQuality});
+}
+} // namespace
+
+// Write a '--size' thumbnail every '--duration' seconds of '--input-uri' to
+// '--output-path', the extension picks the encoder, see utils/image_sink.hpp
+int main(int argc, const char* const* argv)
+{
+  using namespace gfx;
+
+  try
+  {
+    const utils::ArgParser argParser{argc, argv};
+    const std::filesystem::path pattern = argParser.getOutputPath();
+    const time::ms interval             = time::as_ms(argParser.getDuration());
+
+    if (!utils::image::format_for(pattern.string()))
+    {
+      utils::logger::error("no image encoder for '--output-path' {}", pattern.string());
+      return EXIT_FAILURE;
+    }
+    std::filesystem::create_directories(pattern.parent_path());
+
+    utils::video::Demuxer demuxer{argParser.getInputUri()};
+    demuxer.setOutput(utils::video::OutputFormat::RGBA, argParser.getSize());
+
+    if (argParser.getVerbose())
+    {
+      demuxer.dumpFormat();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    int64_t written{0};
+
+    const bool success = demuxer.decodeSparse(
+        interval,
+        [&](const utils::video::Frame& frame) {
+          if (!write_thumbnail(pattern, frame))
+          {
+            utils::logger::error("could not write thumbnail at {} ms",
+                                 frame.timestamp.count());
+            return false;
+          }
+          ++written;
+          return true;
+        });
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now()
+                                                - start;
+
+    utils::logger::info("wrote {} thumbnails in {:.2f} s", written, elapsed.count());
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  catch (const std::exception& e)
+  {
+    std::puts(e.what());
+    return EXIT_FAILURE;
+  }
+}
@@ -8,20 +8,20 @@ __global__ void drawCircleTexture(CUsurfObject surf)
   int y      = (threadIdx.y + blockIdx.y * blockDim.y);
   int radius = 256;
 
-  float4 data = make_float4(0.0f, 0.0f, 0.0f, 0x00);
+  uchar4 data = make_uchar4(0x00, 0x00, 0x00, 0x00);
 
   int2 pos{x - radius, y - radius};
 
   if ((pos.x * pos.x + pos.y * pos.y) <= radius * radius)
   {
-    data.x = 1.0F;
-    data.z = 1.0F;
+    data.x = 0xFF;
+    data.z = 0xFF;
   }
   else
   {
-    data.y = 1.0F;
+    data.y = 0xFF;
   }
-  surf2Dwrite(data, surf, x * sizeof(float4), y, cudaBoundaryModeZero);
+  surf2Dwrite(data, surf, x * sizeof(uchar4), y, cudaBoundaryModeZero);
 }
 
 namespace gfx::compute
@@ -22,14 +22,16 @@ if(NOT
   )
 endif()
 
-target_include_directories(compute_components SYSTEM PRIVATE third_party/stb)
-
 target_include_directories(compute_components PRIVATE gfx)
 
 target_link_libraries(
   compute_components
   CUDA::cuda_driver
-  $<TARGET_OBJECTS:stb_image_implementation>
+  graphics::gpu_profile
+  graphics::pixel_format
+  utils::image_sink
+  utils::profile
+  utils::trace
 )
 
 add_library(compute::components ALIAS compute_components)
@@ -20,7 +20,7 @@ Context::Context()
   constexpr size_t deviceNameLength{80};
   std::array<char, deviceNameLength> deviceName{};
   CUCHECK(cuDeviceGetName(deviceName.data(), deviceName.size(), gpu));
-  utils::logger::info("GPU in use: ", deviceName.data());
+  utils::logger::info("GPU in use: {}", deviceName.data());
   CUCHECK(cuCtxCreate(&_cuContext, CU_CTX_SCHED_BLOCKING_SYNC, cuDevice));
 }
 
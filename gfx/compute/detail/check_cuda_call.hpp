@@ -6,7 +6,6 @@
 
 #if not defined(__clang__)
 #include <source_location>
-#include <string>
 #endif
 
 #ifdef CUCHECK
@@ -27,16 +26,14 @@ checkCudaCall(CUresult result,
 {
   if (result != CUDA_SUCCESS)
   {
-    std::string location_string{};
-    gfx::utils::logger::error(location_string + location.file_name() + ':'
-                              + std::to_string(location.line()));
-    gfx::utils::logger::error(location.function_name());
+    gfx::utils::logger::error("{}:{}", location.file_name(), location.line());
+    gfx::utils::logger::error("{}", location.function_name());
     const char* szErrName = NULL;
     cuGetErrorName(result, &szErrName);
-    gfx::utils::logger::error(szErrName);
+    gfx::utils::logger::error("{}", szErrName);
     const char* szErrString = NULL;
     cuGetErrorString(result, &szErrString);
-    gfx::utils::logger::error(szErrString);
+    gfx::utils::logger::error("{}", szErrString);
   }
 }
 #endif
@@ -1,6 +1,9 @@
 #include "pixel_buffer.hpp"
 
 #include "detail/check_cuda_call.hpp"
+#include "graphics/gpu_profile.hpp"
+#include "utils/profile.hpp"
+#include "utils/trace.hpp"
 #include "vocabulary/size.hpp"
 
 #include <GL/glew.h>
@@ -43,6 +46,15 @@ PixelBuffer::~PixelBuffer()
 
 void PixelBuffer::blitToTexture(unsigned int destination) const
 {
+  static const utils::trace::EventId upload = utils::trace::event("upload");
+  const utils::trace::Scope scope{upload};
+
+  static auto& zone = utils::profile::zone("PixelBuffer::blitToTexture");
+  const utils::profile::Scope profiled{zone};
+
+  static auto& gpuZone = graphics::gpu_profile::zone("PixelBuffer::blitToTexture");
+  const graphics::gpu_profile::Scope gpuProfiled{gpuZone};
+
   glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pbo);
   glBindTexture(GL_TEXTURE_2D, destination);
   glTexSubImage2D(GL_TEXTURE_2D,
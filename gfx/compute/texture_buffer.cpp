@@ -1,6 +1,8 @@
 #include "texture_buffer.hpp"
 
 #include "detail/check_cuda_call.hpp"
+#include "graphics/pixel_format.hpp"
+#include "utils/logger.hpp"
 #include "vocabulary/size.hpp"
 
 #include <GL/glew.h>
@@ -9,22 +11,25 @@
 
 namespace gfx::compute
 {
-TextureBuffer::TextureBuffer(const gfx::Size& size)
+TextureBuffer::TextureBuffer(const gfx::Size& size, graphics::PixelFormat format)
+    : _format{format}
 {
+  if (graphics::pixel_format::is_planar(_format))
+  {
+    utils::logger::fatal("compute::TextureBuffer - planar format, one buffer per "
+                         "plane");
+  }
+
   glGenTextures(1, &_texture);
   glBindTexture(GL_TEXTURE_2D, _texture);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-  glTexImage2D(GL_TEXTURE_2D,
-               0,
-               GL_RGBA32F,
-               static_cast<GLsizei>(size.width),
-               static_cast<GLsizei>(size.height),
-               0,
-               GL_RGBA,
-               GL_FLOAT,
-               nullptr);
+  glTexStorage2D(GL_TEXTURE_2D,
+                 1,
+                 graphics::pixel_format::describe(_format).internalFormat,
+                 static_cast<GLsizei>(size.width),
+                 static_cast<GLsizei>(size.height));
 
   glBindTexture(GL_TEXTURE_2D, 0);
 
@@ -59,4 +64,9 @@ GLuint TextureBuffer::getTexture() const
 {
   return _texture;
 }
+
+graphics::PixelFormat TextureBuffer::getFormat() const
+{
+  return _format;
+}
 } // namespace gfx::compute
@@ -1,20 +1,21 @@
 #pragma once
 
+#include "graphics/pixel_format.hpp"
+#include "vocabulary/size.hpp"
+
 #include <GL/glew.h>
 
 #include <cudaGL.h>
 
-namespace gfx
-{
-struct Size;
-} // namespace gfx
-
 namespace gfx::compute
 {
+// A GL texture CUDA kernels write through a surface, one texel of 'format' per
+// pixel, e.g. uchar4 for RGBA8 and float4 for RGBA32F
 class TextureBuffer
 {
   public:
-    explicit TextureBuffer(const gfx::Size& size);
+    explicit TextureBuffer(const gfx::Size& size,
+                           graphics::PixelFormat format = graphics::PixelFormat::RGBA8);
     ~TextureBuffer();
 
     TextureBuffer operator=(const TextureBuffer&) = delete;
@@ -25,8 +26,10 @@ class TextureBuffer
     [[nodiscard]] CUarray lockCuArray();
     void releaseCuArray();
     [[nodiscard]] GLuint getTexture() const;
+    [[nodiscard]] graphics::PixelFormat getFormat() const;
 
   private:
+    graphics::PixelFormat _format;
     CUgraphicsResource _cuResource{};
     GLuint _texture{};
 };
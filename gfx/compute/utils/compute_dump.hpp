@@ -9,9 +9,16 @@ namespace gfx
 struct Size;
 } // namespace gfx
 
+namespace gfx::utils
+{
+class ThreadPool;
+} // namespace gfx::utils
+
 namespace gfx::compute::utils
 {
+// Blocking, the rows are encoded on 'pool' when given, see dump_texture
 void dump_deviceptr(std::string_view filename,
                     CUdeviceptr deviceptr,
-                    const gfx::Size& size);
+                    const gfx::Size& size,
+                    ::gfx::utils::ThreadPool* pool = nullptr);
 } // namespace gfx::compute::utils
@@ -1,11 +1,28 @@
 #include "compile_shader_program.hpp"
 
+#include "graphics/program_cache.hpp"
 #include "utils/logger.hpp"
 
 #include <GL/glew.h>
+#include <fmt/core.h>
 
+#include <unistd.h>
+
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <vector>
 
 namespace gfx::graphics::detail
 {
@@ -16,7 +33,7 @@ namespace
   constexpr size_t infoLogSize{512};
   std::array<char, infoLogSize> infoLog{};
   glGetShaderInfoLog(shader, infoLogSize, nullptr, infoLog.data());
-  utils::logger::fatal(infoLog.data());
+  utils::logger::fatal("{}", infoLog.data());
 }
 
 unsigned int compileShader(const char* sourceString, GLenum type)
@@ -41,14 +58,30 @@ unsigned int compileShader(const char* sourceString, GLenum type)
   constexpr size_t infoLogSize{512};
   std::array<char, infoLogSize> infoLog{};
   glGetProgramInfoLog(program, infoLogSize, nullptr, infoLog.data());
-  utils::logger::fatal(infoLog.data());
+  utils::logger::fatal("{}", infoLog.data());
 }
 
-template <class T>
-unsigned int createProgram(const T& shaders)
+struct Source
+{
+    GLenum type;
+    const char* text;
+};
+
+unsigned int createProgram(std::span<const Source> sources, bool retrievable)
 {
+  std::vector<unsigned int> shaders{};
+  for (const Source& source : sources)
+  {
+    shaders.push_back(compileShader(source.text, source.type));
+  }
+
   const unsigned int shaderProgram = glCreateProgram();
 
+  if (retrievable)
+  {
+    glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+
   for (const auto& shader : shaders)
   {
     glAttachShader(shaderProgram, shader);
@@ -64,45 +97,272 @@ unsigned int createProgram(const T& shaders)
     fatalProgramError(shaderProgram);
   }
 
+  for (const auto& shader : shaders)
+  {
+    glDeleteShader(shader);
+  }
+
   return shaderProgram;
 }
 
-namespace stage
+// FNV-1a, unlike std::hash the same in every build
+class Hash
+{
+  public:
+    void add(std::string_view data)
+    {
+      for (const char byte : data)
+      {
+        _value = (_value ^ static_cast<uint8_t>(byte)) * prime;
+      }
+      // Separator, "ab" + "c" and "a" + "bc" differ
+      _value *= prime;
+    }
+
+    [[nodiscard]] uint64_t value() const
+    {
+      return _value;
+    }
+
+  private:
+    constexpr static uint64_t prime{0x100000001b3};
+    uint64_t _value{0xcbf29ce484222325};
+};
+
+struct Header
 {
-enum Stage
+    std::array<char, 4> magic{'G', 'F', 'X', 'P'};
+    uint32_t format{0};
+
+    // Nanoseconds it took to compile and link, reported as saved on a hit
+    int64_t compiled{0};
+};
+
+struct Cache
 {
-  vertex,
-  fragment,
-  num_stages
+    std::mutex mutex{};
+    std::filesystem::path directory{};
+    program_cache::Stats stats{};
 };
-} // namespace stage
+
+Cache& cache()
+{
+  static Cache instance{};
+  return instance;
+}
+
+std::filesystem::path entry_for(const std::filesystem::path& directory,
+                                std::span<const Source> sources)
+{
+  Hash hash{};
+  for (const GLenum name : std::array<GLenum, 3>{GL_VENDOR, GL_RENDERER, GL_VERSION})
+  {
+    const auto* string = reinterpret_cast<const char*>(glGetString(name)); // NOLINT
+    hash.add(string == nullptr ? "" : string);
+  }
+  for (const Source& source : sources)
+  {
+    hash.add(fmt::format("{}", source.type));
+    hash.add(source.text);
+  }
+  return directory / fmt::format("{:016x}.bin", hash.value());
+}
+
+// 0 if the entry is unreadable or the driver does not take it
+unsigned int load(const std::filesystem::path& entry, Header& header)
+{
+  std::ifstream file{entry, std::ios::binary};
+  file.read(reinterpret_cast<char*>(&header), sizeof(header)); // NOLINT
+  if (!file || header.magic != Header{}.magic)
+  {
+    return 0;
+  }
+
+  const std::vector<char> binary{std::istreambuf_iterator<char>{file},
+                                 std::istreambuf_iterator<char>{}};
+
+  const unsigned int program = glCreateProgram();
+  glProgramBinary(program,
+                  header.format,
+                  binary.data(),
+                  static_cast<GLsizei>(binary.size()));
+
+  int success{};
+  glGetProgramiv(program, GL_LINK_STATUS, &success);
+  if (success == GL_FALSE)
+  {
+    glDeleteProgram(program);
+    return 0;
+  }
+  return program;
+}
+
+void store(const std::filesystem::path& entry,
+           unsigned int program,
+           std::chrono::nanoseconds compiled)
+{
+  int length{0};
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0)
+  {
+    return;
+  }
+
+  Header header{.compiled = compiled.count()};
+  std::vector<char> binary(static_cast<size_t>(length));
+  glGetProgramBinary(program, length, nullptr, &header.format, binary.data());
+
+  // Written aside and renamed, other processes never read a partial entry. The
+  // name is unique per writer, threads of one process may store the same entry.
+  static std::atomic<uint64_t> writes{0};
+  std::filesystem::path partial = entry;
+  partial += fmt::format(".{}.{}",
+                         getpid(),
+                         writes.fetch_add(1, std::memory_order_relaxed));
+  {
+    std::ofstream file{partial, std::ios::binary};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header)); // NOLINT
+    file.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+  }
+
+  std::error_code error{};
+  std::filesystem::rename(partial, entry, error);
+  if (error)
+  {
+    utils::logger::warning("program cache - could not write {}: {}",
+                           entry.string(),
+                           error.message());
+    std::filesystem::remove(partial, error);
+  }
+}
+
+unsigned int cachedProgram(std::span<const Source> sources)
+{
+  using clock = std::chrono::steady_clock;
+
+  Cache& programs = cache();
+  std::filesystem::path directory{};
+  {
+    const std::scoped_lock lock{programs.mutex};
+    directory = programs.directory;
+  }
+
+  if (directory.empty())
+  {
+    return createProgram(sources, false);
+  }
+
+  const std::filesystem::path entry = entry_for(directory, sources);
+  const auto start                  = clock::now();
+
+  Header header{};
+  const bool exists = std::filesystem::exists(entry);
+  if (exists)
+  {
+    if (const unsigned int program = load(entry, header); program != 0)
+    {
+      const std::chrono::nanoseconds saved{std::chrono::nanoseconds{header.compiled}
+                                           - (clock::now() - start)};
+
+      const std::scoped_lock lock{programs.mutex};
+      ++programs.stats.hits;
+      programs.stats.saved += std::max(saved, std::chrono::nanoseconds{0});
+      return program;
+    }
+  }
+
+  const auto compileStart    = clock::now();
+  const unsigned int program = createProgram(sources, true);
+  const auto compiled        = clock::now() - compileStart;
+
+  store(entry, program, compiled);
+
+  const std::scoped_lock lock{programs.mutex};
+  ++(exists ? programs.stats.rejected : programs.stats.misses);
+  programs.stats.compiled += compiled;
+  return program;
+}
 } // namespace
 
 unsigned int compileShaderProgram(const char* vertSource, const char* fragSource)
 {
-  std::array<unsigned int, stage::num_stages> shaders{};
-  shaders[stage::vertex]   = compileShader(vertSource, GL_VERTEX_SHADER);
-  shaders[stage::fragment] = compileShader(fragSource, GL_FRAGMENT_SHADER);
+  const std::array<Source, 2> sources{
+      {{GL_VERTEX_SHADER, vertSource}, {GL_FRAGMENT_SHADER, fragSource}}
+  };
+  return cachedProgram(sources);
+}
+
+unsigned int compileShaderProgram(const char* compSource)
+{
+  const std::array<Source, 1> sources{
+      {{GL_COMPUTE_SHADER, compSource}}
+  };
+  return cachedProgram(sources);
+}
+} // namespace gfx::graphics::detail
 
-  const unsigned int shaderProgram = createProgram(shaders);
+namespace gfx::graphics::program_cache
+{
+std::filesystem::path default_directory()
+{
+  std::filesystem::path base{};
+  if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg != nullptr && *xdg != '\0')
+  {
+    base = xdg;
+  }
+  else if (const char* home = std::getenv("HOME"); home != nullptr && *home != '\0')
+  {
+    base = std::filesystem::path{home} / ".cache";
+  }
+  else
+  {
+    base = std::filesystem::temp_directory_path();
+  }
+  return base / "gfx" / "programs";
+}
 
-  for (const auto& shader : shaders)
+void enable(const std::filesystem::path& directory)
+{
+  std::error_code error{};
+  std::filesystem::create_directories(directory, error);
+  if (error)
   {
-    glDeleteShader(shader);
+    utils::logger::warning("program cache - disabled, could not create {}: {}",
+                           directory.string(),
+                           error.message());
+    return;
   }
 
-  return shaderProgram;
+  detail::Cache& programs = detail::cache();
+  const std::scoped_lock lock{programs.mutex};
+  programs.directory = directory;
 }
 
-unsigned int compileShaderProgram(const char* compSource)
+void disable()
 {
-  std::array<unsigned int, 1> shaders{};
-  shaders[0] = compileShader(compSource, GL_COMPUTE_SHADER);
+  detail::Cache& programs = detail::cache();
+  const std::scoped_lock lock{programs.mutex};
+  programs.directory.clear();
+}
 
-  const unsigned int shaderProgram = createProgram(shaders);
+Stats stats()
+{
+  detail::Cache& programs = detail::cache();
+  const std::scoped_lock lock{programs.mutex};
+  return programs.stats;
+}
 
-  glDeleteShader(shaders[0]);
+void log_stats()
+{
+  using milliseconds = std::chrono::duration<double, std::milli>;
 
-  return shaderProgram;
+  const Stats current = stats();
+  utils::logger::info("program cache {} hits, {} misses, {} rejected, "
+                      "compiled in {:.1f} ms, saved {:.1f} ms",
+                      current.hits,
+                      current.misses,
+                      current.rejected,
+                      milliseconds(current.compiled).count(),
+                      milliseconds(current.saved).count());
 }
-} // namespace gfx::graphics::detail
+} // namespace gfx::graphics::program_cache
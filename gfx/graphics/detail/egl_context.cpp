@@ -0,0 +1,199 @@
+#include "egl_context.hpp"
+
+#include "utils/logger.hpp"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace gfx::graphics::detail
+{
+namespace
+{
+// Lowest minor the tree runs on, RenderTarget clears with the 4.5 DSA entry
+// points and the streaming buffers use 4.4 glBufferStorage
+constexpr int minimumMinor{5};
+
+bool has_extension(EGLDisplay display, std::string_view name)
+{
+  const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+  if (extensions == nullptr)
+  {
+    return false;
+  }
+
+  // Space separated, a plain search would match prefixes of longer names
+  std::string_view list{extensions};
+  while (!list.empty())
+  {
+    const size_t end = list.find(' ');
+    if (list.substr(0, end) == name)
+    {
+      return true;
+    }
+    list.remove_prefix(end == std::string_view::npos ? list.size() : end + 1);
+  }
+  return false;
+}
+
+// Mesa's surfaceless platform, else the first device, e.g. on NVIDIA
+EGLDisplay offscreen_display()
+{
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  const auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+      eglGetProcAddress("eglGetPlatformDisplayEXT"));
+  if (getPlatformDisplay == nullptr)
+  {
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+  }
+
+  if (has_extension(EGL_NO_DISPLAY, "EGL_MESA_platform_surfaceless"))
+  {
+    return getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA,
+                              EGL_DEFAULT_DISPLAY,
+                              nullptr);
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  const auto queryDevices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(
+      eglGetProcAddress("eglQueryDevicesEXT"));
+  if (queryDevices != nullptr
+      && has_extension(EGL_NO_DISPLAY, "EGL_EXT_platform_device"))
+  {
+    EGLDeviceEXT device{};
+    EGLint count{0};
+    if (queryDevices(1, &device, &count) == EGL_TRUE && count > 0)
+    {
+      return getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, device, nullptr);
+    }
+  }
+
+  return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+EGLDisplay open_display()
+{
+  EGLDisplay display = offscreen_display();
+
+  if (display == EGL_NO_DISPLAY
+      || eglInitialize(display, nullptr, nullptr) == EGL_FALSE)
+  {
+    utils::logger::fatal("graphics::EglContext - no EGL display, error {:#x}",
+                         eglGetError());
+  }
+
+  if (!has_extension(display, "EGL_KHR_surfaceless_context"))
+  {
+    utils::logger::fatal("graphics::EglContext - surfaceless contexts not supported");
+  }
+
+  return display;
+}
+
+EGLConfig choose_config(EGLDisplay display)
+{
+  EGLConfig config = EGL_NO_CONFIG_KHR;
+  if (!has_extension(display, "EGL_KHR_no_config_context"))
+  {
+    const std::array<EGLint, 3> wanted{EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+    EGLint count{0};
+    if (eglChooseConfig(display, wanted.data(), &config, 1, &count) == EGL_FALSE
+        || count == 0)
+    {
+      utils::logger::fatal("graphics::EglContext - no OpenGL capable EGL config");
+    }
+  }
+  return config;
+}
+} // namespace
+
+EglContext::EglContext(int major, int minor, const EglContext* share)
+{
+  if (share != nullptr)
+  {
+    _display = share->_display;
+    _config  = share->_config;
+  }
+  else
+  {
+    _display     = open_display();
+    _config      = choose_config(_display);
+    _ownsDisplay = true;
+  }
+
+  eglBindAPI(EGL_OPENGL_API);
+
+  // Software renderers on render nodes may stop short of the requested minor
+  EGLContext context = EGL_NO_CONTEXT;
+  for (int current = minor; current >= minimumMinor && context == EGL_NO_CONTEXT;
+       --current)
+  {
+    const std::array<EGLint, 7> attributes{EGL_CONTEXT_MAJOR_VERSION,
+                                           major,
+                                           EGL_CONTEXT_MINOR_VERSION,
+                                           current,
+                                           EGL_CONTEXT_OPENGL_PROFILE_MASK,
+                                           EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                                           EGL_NONE};
+    _minor  = current;
+    context = eglCreateContext(_display,
+                               _config,
+                               share != nullptr ? share->_context : EGL_NO_CONTEXT,
+                               attributes.data());
+  }
+
+  if (context == EGL_NO_CONTEXT)
+  {
+    utils::logger::fatal("graphics::EglContext - could not create an OpenGL {}.{} "
+                         "or newer context, error {:#x}",
+                         major,
+                         minimumMinor,
+                         eglGetError());
+  }
+  _context = context;
+  _major   = major;
+
+  if (share == nullptr)
+  {
+    makeCurrent();
+  }
+}
+
+EglContext::~EglContext()
+{
+  if (eglGetCurrentContext() == _context)
+  {
+    release();
+  }
+  eglDestroyContext(_display, _context);
+
+  if (_ownsDisplay)
+  {
+    eglTerminate(_display);
+  }
+}
+
+std::unique_ptr<EglContext> EglContext::createShared() const
+{
+  return std::make_unique<EglContext>(_major, _minor, this);
+}
+
+void EglContext::makeCurrent() const
+{
+  // The bound API is per thread, a worker starts out with OpenGL ES
+  eglBindAPI(EGL_OPENGL_API);
+  if (eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, _context) == EGL_FALSE)
+  {
+    utils::logger::fatal("graphics::EglContext - could not make context current");
+  }
+}
+
+void EglContext::release() const
+{
+  eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+} // namespace gfx::graphics::detail
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+
+namespace gfx::graphics::detail
+{
+// OpenGL core context without a surface or a display server. Draws go to
+// framebuffer objects, see RenderTarget. The first context is made current on
+// construction, one sharing its objects with 'share' is left for makeCurrent on
+// the thread that uses it.
+class EglContext
+{
+  public:
+    EglContext(int major, int minor, const EglContext* share = nullptr);
+    ~EglContext();
+
+    EglContext(const EglContext&)            = delete;
+    EglContext& operator=(const EglContext&) = delete;
+    EglContext(EglContext&&)                 = delete;
+    EglContext& operator=(EglContext&&)      = delete;
+
+    // Same version, sharing the objects of this one, not current
+    [[nodiscard]] std::unique_ptr<EglContext> createShared() const;
+
+    // Current on the calling thread, and not on any other
+    void makeCurrent() const;
+    void release() const;
+
+  private:
+    void* _display{nullptr};
+    void* _config{nullptr};
+    void* _context{nullptr};
+    int _major{0};
+    int _minor{0};
+    bool _ownsDisplay{false};
+};
+} // namespace gfx::graphics::detail
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "graphics/yuv_converter.hpp"
+
+namespace gfx::graphics::detail
+{
+// Kr and Kb of the matrix, Kg is what is left of 1
+struct LumaCoefficients
+{
+    float red;
+    float blue;
+};
+
+constexpr LumaCoefficients luma_coefficients(YuvConverter::Matrix matrix)
+{
+  switch (matrix)
+  {
+    case YuvConverter::Matrix::BT601:
+      return {0.299F, 0.114F};
+    case YuvConverter::Matrix::BT709:
+      return {0.2126F, 0.0722F};
+  }
+  return {0.2126F, 0.0722F};
+}
+} // namespace gfx::graphics::detail
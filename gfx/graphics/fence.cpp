@@ -0,0 +1,70 @@
+#include "fence.hpp"
+
+#include <GL/glew.h>
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+namespace gfx::graphics
+{
+namespace
+{
+GLsync sync_of(void* sync)
+{
+  return static_cast<GLsync>(sync);
+}
+} // namespace
+
+Fence::Fence()
+    : _sync{glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)}
+{
+  // Unflushed, a wait in another context could block forever
+  glFlush();
+}
+
+Fence::~Fence()
+{
+  if (_sync != nullptr)
+  {
+    glDeleteSync(sync_of(_sync));
+  }
+}
+
+Fence::Fence(Fence&& other) noexcept
+    : _sync{std::exchange(other._sync, nullptr)}
+{}
+
+Fence& Fence::operator=(Fence&& other) noexcept
+{
+  if (this != &other)
+  {
+    if (_sync != nullptr)
+    {
+      glDeleteSync(sync_of(_sync));
+    }
+    _sync = std::exchange(other._sync, nullptr);
+  }
+  return *this;
+}
+
+void Fence::wait() const
+{
+  glWaitSync(sync_of(_sync), 0, GL_TIMEOUT_IGNORED);
+}
+
+bool Fence::clientWait(std::chrono::nanoseconds timeout) const
+{
+  const GLenum result = glClientWaitSync(sync_of(_sync),
+                                         0,
+                                         static_cast<uint64_t>(timeout.count()));
+  return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+}
+
+bool Fence::signaled() const
+{
+  GLint status{GL_UNSIGNALED};
+  glGetSynciv(sync_of(_sync), GL_SYNC_STATUS, 1, nullptr, &status);
+  return status == GL_SIGNALED;
+}
+} // namespace gfx::graphics
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <chrono>
+
+namespace gfx::graphics
+{
+// Handoff point between contexts that share objects. Created after the
+// commands that fill a texture or buffer, flushed so other contexts see it.
+// Another context waits on it before its first use of the object and binds
+// the object again afterwards, the GL rule for seeing changes made elsewhere.
+class Fence
+{
+  public:
+    Fence();
+    ~Fence();
+
+    Fence(const Fence&)            = delete;
+    Fence& operator=(const Fence&) = delete;
+    Fence(Fence&& other) noexcept;
+    Fence& operator=(Fence&& other) noexcept;
+
+    // The GPU of the current context waits, the CPU goes on
+    void wait() const;
+
+    // Blocks the CPU up to 'timeout', true when the commands are done
+    [[nodiscard]] bool clientWait(std::chrono::nanoseconds timeout) const;
+
+    [[nodiscard]] bool signaled() const;
+
+  private:
+    void* _sync{nullptr};
+};
+} // namespace gfx::graphics
@@ -0,0 +1,110 @@
+#include "frame_stats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+namespace gfx::graphics
+{
+namespace
+{
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+double nearest_rank(const std::vector<double>& sorted, double quantile)
+{
+  const auto rank = static_cast<size_t>(
+      std::ceil(quantile * static_cast<double>(sorted.size())));
+  return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+// 'values' are sorted in place
+FrameStats::Distribution distribution(std::vector<double>& values)
+{
+  std::ranges::sort(values);
+
+  return {
+      .mean = std::accumulate(values.begin(), values.end(), 0.0)
+            / static_cast<double>(values.size()),
+      .p50  = nearest_rank(values, 0.5),  // NOLINT
+      .p99  = nearest_rank(values, 0.99), // NOLINT
+      .max  = values.back(),
+  };
+}
+} // namespace
+
+FrameStats::FrameStats(size_t capacity, std::optional<std::chrono::nanoseconds> refresh)
+    : _capacity{std::max<size_t>(capacity, 1)},
+      _refresh{refresh}
+{
+  _frames.reserve(_capacity);
+}
+
+void FrameStats::add(const FrameTiming& timing)
+{
+  if (_frames.size() < _capacity)
+  {
+    _frames.push_back(timing);
+    return;
+  }
+
+  _frames[_next] = timing;
+  _next          = (_next + 1) % _capacity;
+}
+
+void FrameStats::clear()
+{
+  _frames.clear();
+  _next = 0;
+}
+
+size_t FrameStats::size() const
+{
+  return _frames.size();
+}
+
+FrameStats::Summary FrameStats::summary() const
+{
+  if (_frames.empty())
+  {
+    return {};
+  }
+
+  std::vector<double> cpu{};
+  std::vector<double> swap{};
+  std::vector<double> interval{};
+  cpu.reserve(_frames.size());
+  swap.reserve(_frames.size());
+  interval.reserve(_frames.size());
+
+  for (const FrameTiming& frame : _frames)
+  {
+    cpu.push_back(Milliseconds{frame.cpu}.count());
+    swap.push_back(Milliseconds{frame.swap}.count());
+    interval.push_back(Milliseconds{frame.interval}.count());
+  }
+
+  Summary summary{
+      .frames   = _frames.size(),
+      .cpu      = distribution(cpu),
+      .swap     = distribution(swap),
+      .interval = distribution(interval),
+  };
+
+  summary.fps = summary.interval.mean > 0.0 ? 1000.0 / summary.interval.mean : 0.0;
+
+  constexpr double missedFactor{1.5};
+  const double period = _refresh ? Milliseconds{*_refresh}.count()
+                                 : summary.interval.p50;
+
+  // 'interval' is sorted
+  summary.missed = static_cast<size_t>(std::distance(
+      std::ranges::upper_bound(interval, period * missedFactor),
+      interval.end()));
+
+  return summary;
+}
+} // namespace gfx::graphics
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace gfx::graphics
+{
+struct FrameTiming
+{
+    std::chrono::nanoseconds cpu;      // end of last swap until this swap is called
+    std::chrono::nanoseconds swap;     // blocked in glfwSwapBuffers
+    std::chrono::nanoseconds interval; // between the ends of two swaps
+};
+
+// Timings of the last 'capacity' frames, filled and read on the render thread
+class FrameStats
+{
+  public:
+    // Milliseconds
+    struct Distribution
+    {
+        double mean{};
+        double p50{};
+        double p99{};
+        double max{};
+    };
+
+    struct Summary
+    {
+        size_t frames{};
+        double fps{};
+        Distribution cpu{};
+        Distribution swap{};
+        Distribution interval{};
+
+        // Intervals longer than one and a half refresh periods
+        size_t missed{};
+    };
+
+    // Without a refresh period missed frames are judged against the median interval
+    explicit FrameStats(size_t capacity = 600, // NOLINT
+                        std::optional<std::chrono::nanoseconds> refresh = {});
+
+    void add(const FrameTiming& timing);
+    void clear();
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] Summary summary() const;
+
+  private:
+    std::vector<FrameTiming> _frames{};
+    size_t _next{0};
+    size_t _capacity;
+    std::optional<std::chrono::nanoseconds> _refresh;
+};
+} // namespace gfx::graphics
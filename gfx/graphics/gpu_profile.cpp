@@ -0,0 +1,182 @@
+#include "gpu_profile.hpp"
+
+#include "utils/profile.hpp"
+
+#include <GL/glew.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gfx::graphics::gpu_profile
+{
+namespace
+{
+// Scopes in flight per thread, several frames of a few hundred scopes each
+constexpr size_t capacity{1024};
+
+std::atomic<uint64_t> droppedScopes{0};
+
+// Query objects belong to the context, one pool per thread and so per context.
+// Names are not deleted on thread exit, the context may be gone by then.
+// Slots are reused as soon as their scope is read, an open scope such as the
+// frame around everything else does not hold back the ones it encloses.
+class Pool
+{
+  public:
+    Pool()
+    {
+      _free.reserve(capacity);
+      _pending.reserve(capacity);
+      for (size_t slot = capacity; slot > 0; --slot)
+      {
+        _free.push_back(slot - 1);
+      }
+    }
+
+    int64_t begin(utils::profile::Zone& zone)
+    {
+      if (_free.empty())
+      {
+        collect(false);
+      }
+
+      if (_free.empty())
+      {
+        droppedScopes.fetch_add(1, std::memory_order_relaxed);
+        return -1;
+      }
+
+      if (!_generated)
+      {
+        glGenQueries(static_cast<GLsizei>(_queries.size()), _queries.data());
+        _generated = true;
+      }
+
+      const size_t slot = _free.back();
+      _free.pop_back();
+      _pending.push_back(slot);
+
+      _entries[slot] = {&zone, false};
+      glQueryCounter(_queries[slot * 2], GL_TIMESTAMP);
+      return static_cast<int64_t>(slot);
+    }
+
+    void end(int64_t slot)
+    {
+      const auto index = static_cast<size_t>(slot);
+      glQueryCounter(_queries[index * 2 + 1], GL_TIMESTAMP);
+      _entries[index].ended = true;
+    }
+
+    // In issue order, timestamps of later queries are never available earlier,
+    // so the first one still in flight ends the reads. Open scopes stay pending.
+    void collect(bool wait)
+    {
+      bool reading{true};
+      size_t kept{0};
+      for (const size_t slot : _pending)
+      {
+        if (reading && _entries[slot].ended && _read(slot, wait))
+        {
+          _free.push_back(slot);
+          continue;
+        }
+
+        reading = reading && !_entries[slot].ended;
+        _pending[kept++] = slot;
+      }
+      _pending.resize(kept);
+    }
+
+  private:
+    struct Entry
+    {
+        utils::profile::Zone* zone{nullptr};
+        bool ended{false};
+    };
+
+    bool _read(size_t slot, bool wait)
+    {
+      const GLuint first = _queries[slot * 2];
+      const GLuint last  = _queries[slot * 2 + 1];
+
+      if (!wait)
+      {
+        GLint available{GL_FALSE};
+        glGetQueryObjectiv(last, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE)
+        {
+          return false;
+        }
+      }
+
+      GLuint64 start{0};
+      GLuint64 stop{0};
+      glGetQueryObjectui64v(first, GL_QUERY_RESULT, &start);
+      glGetQueryObjectui64v(last, GL_QUERY_RESULT, &stop);
+      _entries[slot].zone->histogram.add(stop > start ? stop - start : 0);
+      return true;
+    }
+
+    std::array<GLuint, capacity * 2> _queries{};
+    std::array<Entry, capacity> _entries{};
+
+    // Slots of started scopes in issue order, and the unused ones
+    std::vector<size_t> _pending{};
+    std::vector<size_t> _free{};
+    bool _generated{false};
+};
+
+Pool& pool()
+{
+  thread_local Pool instance{};
+  return instance;
+}
+} // namespace
+
+utils::profile::Zone& zone(std::string_view name)
+{
+  if constexpr (!utils::profile::compiled)
+  {
+    return utils::profile::zone(name);
+  }
+  return utils::profile::zone(std::string{name} + " (gpu)");
+}
+
+Scope::Scope(utils::profile::Zone& zone)
+{
+  if constexpr (utils::profile::compiled)
+  {
+    _slot = pool().begin(zone);
+  }
+}
+
+Scope::~Scope()
+{
+  if constexpr (utils::profile::compiled)
+  {
+    if (_slot >= 0)
+    {
+      pool().end(_slot);
+    }
+  }
+}
+
+void collect(bool wait)
+{
+  if constexpr (utils::profile::compiled)
+  {
+    pool().collect(wait);
+  }
+}
+
+uint64_t dropped()
+{
+  return droppedScopes.load(std::memory_order_relaxed);
+}
+} // namespace gfx::graphics::gpu_profile
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "utils/profile.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+// GPU time of OpenGL work, next to the CPU zones of utils/profile.hpp, e.g.
+//   static auto& gpuZone = gpu_profile::zone("Quad::draw");
+//   const gpu_profile::Scope gpuScope{gpuZone};
+// A scope brackets its commands with two GL_TIMESTAMP queries from a pool per
+// thread. Results are read when they are available, frames later, by the
+// window swaps, 'collect' or a scope that finds the pool full, never by waiting
+// on the GPU. Scopes nest.
+namespace gfx::graphics::gpu_profile
+{
+// The CPU zone of the same name with " (gpu)" appended, so summaries list both
+[[nodiscard]] utils::profile::Zone& zone(std::string_view name);
+
+// Only on a thread with a current OpenGL context, the one the scopes used
+class Scope
+{
+  public:
+    explicit Scope(utils::profile::Zone& zone);
+    ~Scope();
+
+    Scope(const Scope&)            = delete;
+    Scope& operator=(const Scope&) = delete;
+    Scope(Scope&&)                 = delete;
+    Scope& operator=(Scope&&)      = delete;
+
+  private:
+    // Pool slot, -1 when the scope is not timed
+    int64_t _slot{-1};
+};
+
+// Read every result that is available on this thread's pool, 'wait' blocks on
+// the rest, e.g. before the last summary
+void collect(bool wait = false);
+
+// Scopes left untimed because every query pair was still in flight, the GPU is
+// more than the pool behind
+[[nodiscard]] uint64_t dropped();
+} // namespace gfx::graphics::gpu_profile
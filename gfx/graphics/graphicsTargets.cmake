@@ -1,25 +1,79 @@
+gfx_static_library_target(
+  frame_stats
+  TARGET frame_stats
+  NAMESPACE graphics
+  SOURCES ${CMAKE_CURRENT_LIST_DIR}/frame_stats.cpp
+  INTERFACE_HEADERS ${CMAKE_CURRENT_LIST_DIR}/frame_stats.hpp
+)
+
+gfx_static_library_target(
+  gpu_profile
+  TARGET gpu_profile
+  NAMESPACE graphics
+  SOURCES ${CMAKE_CURRENT_LIST_DIR}/gpu_profile.cpp
+  INTERFACE_HEADERS ${CMAKE_CURRENT_LIST_DIR}/gpu_profile.hpp
+  DEPENDENCIES
+    ${GL_LIB}
+    GLEW
+    vocabulary
+    utils::profile
+)
+
+gfx_static_library_target(
+  pixel_format
+  TARGET pixel_format
+  NAMESPACE graphics
+  SOURCES ${CMAKE_CURRENT_LIST_DIR}/pixel_format.cpp
+  INTERFACE_HEADERS ${CMAKE_CURRENT_LIST_DIR}/pixel_format.hpp
+  DEPENDENCIES
+    ${GL_LIB}
+    GLEW
+    vocabulary
+)
+
 gfx_static_library_target(
   window
   TARGET window
   NAMESPACE graphics
-  SOURCES ${CMAKE_CURRENT_LIST_DIR}/window.cpp
+  SOURCES
+    ${CMAKE_CURRENT_LIST_DIR}/window.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/fence.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/shared_context.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/upload_thread.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/detail/egl_context.cpp
   INTERFACE_HEADERS ${CMAKE_CURRENT_LIST_DIR}/window.hpp
   DEPENDENCIES
     ${GL_LIB}
+    ${EGL_LIB}
     glfw
     GLEW
+    pthread
     vocabulary
+    graphics::frame_stats
+    graphics::gpu_profile
+    utils::logger
+    utils::trace
 )
 
 add_library(components STATIC)
 target_sources(
   components
   PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/planar_texture.cpp
     ${CMAKE_CURRENT_LIST_DIR}/quad.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/quad_batch.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/render_target.cpp
     ${CMAKE_CURRENT_LIST_DIR}/shader.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/skyline_packer.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/streaming_texture.cpp
     ${CMAKE_CURRENT_LIST_DIR}/detail/compile_shader_program.cpp
     ${CMAKE_CURRENT_LIST_DIR}/texture.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/texture_atlas.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/uniform_buffer.cpp
     ${CMAKE_CURRENT_LIST_DIR}/utils/graphics_dump.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/utils/texture_readback.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/yuv_converter.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/yuv_texture_shader.cpp
 )
 
 target_include_directories(components PRIVATE gfx)
@@ -27,8 +81,12 @@ target_include_directories(components PRIVATE gfx)
 target_link_libraries(
   components
   ${GL_LIB}
-  stb_image_implementation
   GLEW
+  graphics::gpu_profile
+  graphics::pixel_format
+  utils::image_sink
+  utils::profile
+  utils::thread_pool
 )
 
 add_custom_target(
@@ -42,9 +100,21 @@ add_custom_target(
     python3 ${CMAKE_SOURCE_DIR}/tools/glsl_file_to_string.py --program-name
     texture --shader-stages vertex fragment --shaders-path
     ${CMAKE_SOURCE_DIR}/gfx/shaders/
+  COMMAND
+    python3 ${CMAKE_SOURCE_DIR}/tools/glsl_file_to_string.py --program-name
+    quad_batch --shader-stages vertex fragment --shaders-path
+    ${CMAKE_SOURCE_DIR}/gfx/shaders/
   COMMAND
     python3 ${CMAKE_SOURCE_DIR}/tools/glsl_file_to_string.py --program-name yuv
     --shader-stages compute --shaders-path ${CMAKE_SOURCE_DIR}/gfx/shaders/
+  COMMAND
+    python3 ${CMAKE_SOURCE_DIR}/tools/glsl_file_to_string.py --program-name
+    rgb_to_yuv --shader-stages compute --shaders-path
+    ${CMAKE_SOURCE_DIR}/gfx/shaders/
+  COMMAND
+    python3 ${CMAKE_SOURCE_DIR}/tools/glsl_file_to_string.py --program-name
+    yuv_texture --shader-stages fragment --shaders-path
+    ${CMAKE_SOURCE_DIR}/gfx/shaders/
 )
 
 add_dependencies(components ${CMAKE_PROJECT_NAME}_generate_glsl_string)
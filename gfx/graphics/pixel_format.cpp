@@ -0,0 +1,90 @@
+#include "pixel_format.hpp"
+
+#include "utils/logger.hpp"
+#include "vocabulary/size.hpp"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace gfx::graphics::pixel_format
+{
+bool is_planar(PixelFormat format)
+{
+  return format == PixelFormat::NV12 || format == PixelFormat::I420;
+}
+
+Gl describe(PixelFormat format)
+{
+  switch (format)
+  {
+    case PixelFormat::R8:
+      return {GL_R8, GL_RED, GL_UNSIGNED_BYTE, 1};
+    case PixelFormat::RG8:
+      return {GL_RG8, GL_RG, GL_UNSIGNED_BYTE, 2};
+    case PixelFormat::RGBA8:
+      return {GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4};
+    case PixelFormat::RGBA16F:
+      return {GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, 8};
+    case PixelFormat::RGBA32F:
+      return {GL_RGBA32F, GL_RGBA, GL_FLOAT, 16};
+    case PixelFormat::NV12:
+    case PixelFormat::I420:
+      break;
+  }
+
+  utils::logger::fatal("graphics::pixel_format - planar format has no single GL "
+                       "format, describe its planes");
+}
+
+std::vector<Plane> planes(PixelFormat format, gfx::Size size)
+{
+  const auto width  = static_cast<size_t>(size.width);
+  const auto height = static_cast<size_t>(size.height);
+
+  if (!is_planar(format))
+  {
+    return {{format, size, 0, width * describe(format).bytesPerPixel}};
+  }
+
+  // Chroma is subsampled 2x2, odd sizes round up like the codecs do
+  const size_t chromaWidth  = (width + 1) / 2;
+  const size_t chromaHeight = (height + 1) / 2;
+  const gfx::Size chromaSize{chromaWidth, chromaHeight};
+  const size_t lumaSize = width * height;
+
+  if (format == PixelFormat::NV12)
+  {
+    return {{PixelFormat::R8, size, 0, width},
+            {PixelFormat::RG8, chromaSize, lumaSize, chromaWidth * 2}};
+  }
+
+  const size_t chromaPlaneSize = chromaWidth * chromaHeight;
+  return {{PixelFormat::R8, size, 0, width},
+          {PixelFormat::R8, chromaSize, lumaSize, chromaWidth},
+          {PixelFormat::R8, chromaSize, lumaSize + chromaPlaneSize, chromaWidth}};
+}
+
+size_t frame_size(PixelFormat format, gfx::Size size)
+{
+  size_t bytes{0};
+  for (const Plane& plane : planes(format, size))
+  {
+    bytes += plane.stride * static_cast<size_t>(plane.size.height);
+  }
+  return bytes;
+}
+
+size_t mip_levels(gfx::Size size)
+{
+  const size_t largest = std::max<size_t>({size.width, size.height, 1});
+
+  // bit_width, whose return type differs between libstdc++ versions
+  return static_cast<size_t>(std::numeric_limits<size_t>::digits)
+       - static_cast<size_t>(std::countl_zero(largest));
+}
+} // namespace gfx::graphics::pixel_format
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "vocabulary/size.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace gfx::graphics
+{
+// What a texture holds, the storage is allocated from it once with
+// glTexStorage2D. NV12 and I420 are 4:2:0 frames with the planes back to back,
+// one texture per plane, see pixel_format::planes.
+enum class PixelFormat
+{
+  R8,
+  RG8,
+  RGBA8,
+  RGBA16F,
+  RGBA32F,
+  NV12,
+  I420
+};
+
+namespace pixel_format
+{
+// The arguments glTexStorage2D and glTexSubImage2D take for a single plane
+struct Gl
+{
+    unsigned int internalFormat;
+    unsigned int format;
+    unsigned int type;
+    size_t bytesPerPixel;
+};
+
+struct Plane
+{
+    PixelFormat format;
+    gfx::Size size;
+
+    // Bytes into the frame and per row, rows are tightly packed
+    size_t offset;
+    size_t stride;
+};
+
+[[nodiscard]] bool is_planar(PixelFormat format);
+
+// Fatal for the planar formats, describe their planes instead
+[[nodiscard]] Gl describe(PixelFormat format);
+
+// The format itself for the single plane formats, Y then Cb and Cr for I420 or
+// CbCr for NV12, the layout YuvConverter writes
+[[nodiscard]] std::vector<Plane> planes(PixelFormat format, gfx::Size size);
+
+// Bytes of a tightly packed frame, all planes
+[[nodiscard]] size_t frame_size(PixelFormat format, gfx::Size size);
+
+// Levels of a full mip chain down to 1x1
+[[nodiscard]] size_t mip_levels(gfx::Size size);
+} // namespace pixel_format
+} // namespace gfx::graphics
@@ -0,0 +1,89 @@
+#include "planar_texture.hpp"
+
+#include "pixel_format.hpp"
+#include "texture.hpp"
+#include "utils/logger.hpp"
+#include "vocabulary/size.hpp"
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace gfx::graphics
+{
+PlanarTexture::PlanarTexture(const gfx::Size& size, PixelFormat format)
+    : _size{size},
+      _format{format},
+      _layout{pixel_format::planes(format, size)}
+{
+  for (const pixel_format::Plane& plane : _layout)
+  {
+    _planes.push_back(std::make_unique<Texture>(plane.size, plane.format));
+
+    // Chroma is sampled between texels when drawn at luma resolution
+    _planes.back()->bind();
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  }
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+PlanarTexture::~PlanarTexture() = default;
+
+void PlanarTexture::upload(std::span<const uint8_t> frame) const
+{
+  if (frame.size() < frameSize())
+  {
+    utils::logger::error("graphics::PlanarTexture - {} bytes for a {} byte frame",
+                         frame.size(),
+                         frameSize());
+    return;
+  }
+
+  for (size_t index = 0; index < _planes.size(); ++index)
+  {
+    _planes[index]->upload(frame.subspan(_layout[index].offset).data());
+  }
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void PlanarTexture::bind(unsigned int firstUnit) const
+{
+  for (size_t index = 0; index < _planes.size(); ++index)
+  {
+    glActiveTexture(GL_TEXTURE0 + firstUnit + static_cast<GLenum>(index));
+    _planes[index]->bind();
+  }
+  glActiveTexture(GL_TEXTURE0);
+}
+
+const Texture& PlanarTexture::plane(size_t index) const
+{
+  return *_planes.at(index);
+}
+
+size_t PlanarTexture::planes() const
+{
+  return _planes.size();
+}
+
+gfx::Size PlanarTexture::size() const
+{
+  return _size;
+}
+
+PixelFormat PlanarTexture::format() const
+{
+  return _format;
+}
+
+size_t PlanarTexture::frameSize() const
+{
+  return pixel_format::frame_size(_format, _size);
+}
+} // namespace gfx::graphics
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "pixel_format.hpp"
+#include "texture.hpp"
+#include "vocabulary/size.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace gfx::graphics
+{
+// A frame of any PixelFormat as one Texture per plane, e.g. a decoded I420
+// frame as three R8 textures or NV12 as R8 and RG8, sampled by a shader that
+// does the colour conversion.
+//
+//   PlanarTexture frame{size, PixelFormat::NV12};
+//   frame.upload(decoded);  // every frame
+//   frame.bind(0);          // Y on unit 0, CbCr on unit 1
+class PlanarTexture
+{
+  public:
+    PlanarTexture(const gfx::Size& size, PixelFormat format);
+    ~PlanarTexture();
+
+    PlanarTexture(const PlanarTexture&)            = delete;
+    PlanarTexture& operator=(const PlanarTexture&) = delete;
+    PlanarTexture(PlanarTexture&&)                 = delete;
+    PlanarTexture& operator=(PlanarTexture&&)      = delete;
+
+    // 'frame' holds the planes back to back, frameSize bytes
+    void upload(std::span<const uint8_t> frame) const;
+
+    // Plane 'i' on texture unit 'firstUnit' + i, the active unit is left at 0
+    void bind(unsigned int firstUnit = 0) const;
+
+    [[nodiscard]] const Texture& plane(size_t index) const;
+    [[nodiscard]] size_t planes() const;
+
+    [[nodiscard]] gfx::Size size() const;
+    [[nodiscard]] PixelFormat format() const;
+    [[nodiscard]] size_t frameSize() const;
+
+  private:
+    gfx::Size _size;
+    PixelFormat _format;
+    std::vector<pixel_format::Plane> _layout;
+    std::vector<std::unique_ptr<Texture>> _planes{};
+};
+} // namespace gfx::graphics
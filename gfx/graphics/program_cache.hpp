@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+
+namespace gfx::graphics::program_cache
+{
+// Linked program binaries on disk, keyed by a hash of the GLSL sources and the
+// driver's GL_VENDOR, GL_RENDERER and GL_VERSION. Once enabled every Shader
+// loads through glProgramBinary and falls back to compiling when there is no
+// entry or the driver rejects it, e.g. after an update.
+struct Stats
+{
+    size_t hits{0};
+    size_t misses{0};
+
+    // Entries the driver did not accept, compiled and replaced
+    size_t rejected{0};
+
+    // Compile and link time of the misses
+    std::chrono::nanoseconds compiled{0};
+
+    // Compile time recorded with each hit minus the time to load it
+    std::chrono::nanoseconds saved{0};
+};
+
+// $XDG_CACHE_HOME/gfx/programs, ~/.cache/gfx/programs without it
+[[nodiscard]] std::filesystem::path default_directory();
+
+// Created if missing, off by default
+void enable(const std::filesystem::path& directory = default_directory());
+void disable();
+
+[[nodiscard]] Stats stats();
+void log_stats();
+} // namespace gfx::graphics::program_cache
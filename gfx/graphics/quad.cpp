@@ -1,5 +1,8 @@
 #include "quad.hpp"
 
+#include "gpu_profile.hpp"
+#include "utils/profile.hpp"
+
 #include <GL/glew.h>
 
 #include <array>
@@ -86,6 +89,13 @@ Quad::Quad()
 
 void Quad::draw() const
 {
+  // Submission only, the GPU draws later
+  static auto& zone = utils::profile::zone("Quad::draw");
+  const utils::profile::Scope scope{zone};
+
+  static auto& gpuZone = gpu_profile::zone("Quad::draw");
+  const gpu_profile::Scope gpuScope{gpuZone};
+
   glBindVertexArray(_vao);
   glDrawElements(GL_TRIANGLES, Detail::numVertices, GL_UNSIGNED_BYTE, nullptr);
 }
@@ -0,0 +1,189 @@
+#include "quad_batch.hpp"
+
+#include "gpu_profile.hpp"
+#include "shader.hpp"
+#include "shaders/quad_batch.hpp"
+#include "utils/logger.hpp"
+#include "utils/profile.hpp"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace gfx::graphics
+{
+namespace
+{
+namespace attribute
+{
+enum Attribute
+{
+  rect          = 0,
+  rotationLayer = 1,
+  color         = 2,
+  uv            = 3
+};
+} // namespace attribute
+
+// Tightly packed, the vertex attribute offsets below depend on it
+static_assert(sizeof(QuadBatch::Instance) == 44);
+
+constexpr size_t cornersPerQuad{4};
+
+// One second, a fence that takes longer means the context is gone
+constexpr GLuint64 fenceTimeout{1'000'000'000};
+
+void instanceAttribute(GLuint index, GLint components, GLenum type, size_t offset)
+{
+  glVertexAttribPointer(index,
+                        components,
+                        type,
+                        type == GL_UNSIGNED_BYTE ? GL_TRUE : GL_FALSE,
+                        sizeof(QuadBatch::Instance),
+                        reinterpret_cast<const void*>(offset)); // NOLINT
+  glVertexAttribDivisor(index, 1);
+  glEnableVertexAttribArray(index);
+}
+} // namespace
+
+QuadBatch::QuadBatch(size_t capacity, size_t depth)
+    : _shader{shaders::QuadBatch::vertex, shaders::QuadBatch::fragment},
+      _capacity{std::max<size_t>(capacity, 1)},
+      _fences(std::max<size_t>(depth, 1), nullptr)
+{
+  constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT
+                             | GL_MAP_COHERENT_BIT;
+
+  const auto bufferSize = static_cast<GLsizeiptr>(sizeof(Instance) * _capacity
+                                                  * _fences.size());
+
+  glGenVertexArrays(1, &_vao);
+  glBindVertexArray(_vao);
+
+  glGenBuffers(1, &_buffer);
+  glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+  glBufferStorage(GL_ARRAY_BUFFER, bufferSize, nullptr, flags);
+  _mapped = static_cast<Instance*>(
+      glMapBufferRange(GL_ARRAY_BUFFER, 0, bufferSize, flags));
+
+  instanceAttribute(attribute::rect, 4, GL_FLOAT, offsetof(Instance, x));
+  instanceAttribute(attribute::rotationLayer,
+                    2,
+                    GL_FLOAT,
+                    offsetof(Instance, rotation));
+  instanceAttribute(attribute::color, 4, GL_UNSIGNED_BYTE, offsetof(Instance, color));
+  instanceAttribute(attribute::uv, 4, GL_FLOAT, offsetof(Instance, uv));
+
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  if (_mapped == nullptr)
+  {
+    utils::logger::fatal("graphics::QuadBatch - could not map instance buffer");
+  }
+}
+
+QuadBatch::~QuadBatch()
+{
+  for (GLsync fence : _fences)
+  {
+    glDeleteSync(fence);
+  }
+
+  glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+  glUnmapBuffer(GL_ARRAY_BUFFER);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glDeleteBuffers(1, &_buffer);
+  glDeleteVertexArrays(1, &_vao);
+}
+
+bool QuadBatch::add(const Instance& instance)
+{
+  if (_count == _capacity)
+  {
+    return false;
+  }
+
+  _acquire();
+
+  _mapped[_region * _capacity + _count] = instance; // NOLINT
+  ++_count;
+  return true;
+}
+
+void QuadBatch::draw(unsigned int textureArray)
+{
+  static auto& zone = utils::profile::zone("QuadBatch::draw");
+  const utils::profile::Scope scope{zone};
+
+  if (_count == 0)
+  {
+    return;
+  }
+
+  static auto& gpuZone = gpu_profile::zone("QuadBatch::draw");
+  const gpu_profile::Scope gpuScope{gpuZone};
+
+  _shader.use();
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray);
+
+  glBindVertexArray(_vao);
+  glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP,
+                                    0,
+                                    cornersPerQuad,
+                                    static_cast<GLsizei>(_count),
+                                    static_cast<GLuint>(_region * _capacity));
+  glBindVertexArray(0);
+
+  // Signals once the GPU read this region, it is written again 'depth' draws later
+  _fences[_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+  _region   = (_region + 1) % _fences.size();
+  _count    = 0;
+  _acquired = false;
+}
+
+size_t QuadBatch::size() const
+{
+  return _count;
+}
+
+size_t QuadBatch::capacity() const
+{
+  return _capacity;
+}
+
+size_t QuadBatch::depth() const
+{
+  return _fences.size();
+}
+
+void QuadBatch::_acquire()
+{
+  if (_acquired)
+  {
+    return;
+  }
+  _acquired = true;
+
+  GLsync& fence = _fences[_region];
+  if (fence == nullptr)
+  {
+    return;
+  }
+
+  const GLenum result = glClientWaitSync(fence,
+                                         GL_SYNC_FLUSH_COMMANDS_BIT,
+                                         fenceTimeout);
+  if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED)
+  {
+    utils::logger::error("graphics::QuadBatch - instance fence did not signal");
+  }
+
+  glDeleteSync(fence);
+  fence = nullptr;
+}
+} // namespace gfx::graphics
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "shader.hpp"
+
+#include <GL/glew.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gfx::graphics
+{
+// Draws many quads, e.g. the tiles of a video wall, with one instanced call
+// instead of one Quad::draw and uniform update per quad. Instances are written
+// straight into a persistently mapped buffer split into 'depth' regions, one
+// per frame in flight, the CPU only waits when it laps the GPU.
+//
+//   batch.add({.x = -0.5F, .halfWidth = 0.5F, .layer = 3});  // every quad
+//   batch.draw(textureArray);                                // once per frame
+class QuadBatch
+{
+  public:
+    struct Instance
+    {
+        // Centre and half size in normalized device coordinates
+        float x{0.0F};
+        float y{0.0F};
+        float halfWidth{1.0F};
+        float halfHeight{1.0F};
+
+        // Radians counter-clockwise around the centre
+        float rotation{0.0F};
+
+        // GL_TEXTURE_2D_ARRAY layer, negative draws 'color' untextured
+        float layer{-1.0F};
+
+        // RGBA, multiplies the texel
+        std::array<uint8_t, 4> color{0xFF, 0xFF, 0xFF, 0xFF};
+
+        // u0, v0, u1, v1 of the layer, e.g. TextureAtlas::Region::uv
+        std::array<float, 4> uv{0.0F, 0.0F, 1.0F, 1.0F};
+    };
+
+    explicit QuadBatch(size_t capacity = 65536, size_t depth = 3);
+    ~QuadBatch();
+
+    QuadBatch(const QuadBatch&)            = delete;
+    QuadBatch& operator=(const QuadBatch&) = delete;
+    QuadBatch(QuadBatch&&)                 = delete;
+    QuadBatch& operator=(QuadBatch&&)      = delete;
+
+    // Queue a quad for the next draw, false once 'capacity' quads are queued
+    bool add(const Instance& instance);
+
+    // Everything added since the last draw, blending is left to the caller
+    void draw(unsigned int textureArray = 0);
+
+    // Quads added since the last draw
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] size_t capacity() const;
+    [[nodiscard]] size_t depth() const;
+
+  private:
+    Shader _shader;
+    size_t _capacity;
+    unsigned int _vao{0};
+    unsigned int _buffer{0};
+    Instance* _mapped{nullptr};
+    std::vector<GLsync> _fences;
+    size_t _region{0};
+    size_t _count{0};
+    bool _acquired{false};
+
+    void _acquire();
+};
+} // namespace gfx::graphics
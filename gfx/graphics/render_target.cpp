@@ -0,0 +1,180 @@
+#include "render_target.hpp"
+
+#include "utils/logger.hpp"
+#include "vocabulary/size.hpp"
+
+#include <GL/glew.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace gfx::graphics
+{
+namespace
+{
+GLenum attachment_point(size_t attachment)
+{
+  return GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(attachment);
+}
+} // namespace
+
+RenderTarget::RenderTarget(gfx::Size size, size_t colorAttachments, bool depth)
+    : _size{size},
+      _colors(colorAttachments, 0)
+{
+  GLint maxAttachments{0};
+  glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, &maxAttachments);
+  if (_colors.empty() || _colors.size() > static_cast<size_t>(maxAttachments))
+  {
+    utils::logger::fatal("graphics::RenderTarget - {} colour attachments, supported "
+                         "are 1 to {}",
+                         _colors.size(),
+                         maxAttachments);
+  }
+
+  const auto width  = static_cast<GLsizei>(_size.width);
+  const auto height = static_cast<GLsizei>(_size.height);
+
+  glGenFramebuffers(1, &_framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+
+  // Draw buffers are framebuffer state, set once
+  std::vector<GLenum> buffers(_colors.size());
+
+  glGenTextures(static_cast<GLsizei>(_colors.size()), _colors.data());
+  for (size_t index = 0; index < _colors.size(); ++index)
+  {
+    buffers[index] = attachment_point(index);
+
+    glBindTexture(GL_TEXTURE_2D, _colors[index]);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glFramebufferTexture2D(GL_FRAMEBUFFER,
+                           buffers[index],
+                           GL_TEXTURE_2D,
+                           _colors[index],
+                           0);
+  }
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glDrawBuffers(static_cast<GLsizei>(buffers.size()), buffers.data());
+
+  if (depth)
+  {
+    glGenRenderbuffers(1, &_depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, _depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER,
+                              GL_DEPTH_STENCIL_ATTACHMENT,
+                              GL_RENDERBUFFER,
+                              _depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+  }
+
+  const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+  if (status != GL_FRAMEBUFFER_COMPLETE)
+  {
+    utils::logger::fatal("graphics::RenderTarget - {}x{} framebuffer incomplete, "
+                         "status {:#x}",
+                         width,
+                         height,
+                         status);
+  }
+}
+
+RenderTarget::~RenderTarget()
+{
+  glDeleteFramebuffers(1, &_framebuffer);
+  glDeleteTextures(static_cast<GLsizei>(_colors.size()), _colors.data());
+  glDeleteRenderbuffers(1, &_depth);
+}
+
+void RenderTarget::bind() const
+{
+  glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+  glViewport(0,
+             0,
+             static_cast<GLsizei>(_size.width),
+             static_cast<GLsizei>(_size.height));
+}
+
+void RenderTarget::unbind(gfx::Size viewport)
+{
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  glViewport(0,
+             0,
+             static_cast<GLsizei>(viewport.width),
+             static_cast<GLsizei>(viewport.height));
+}
+
+void RenderTarget::clear(float red, float green, float blue, float alpha) const
+{
+  const std::array<GLfloat, 4> color{red, green, blue, alpha};
+  for (size_t index = 0; index < _colors.size(); ++index)
+  {
+    glClearNamedFramebufferfv(_framebuffer,
+                              GL_COLOR,
+                              static_cast<GLint>(index),
+                              color.data());
+  }
+
+  if (_depth != 0)
+  {
+    glClearNamedFramebufferfi(_framebuffer, GL_DEPTH_STENCIL, 0, 1.0F, 0);
+  }
+}
+
+void RenderTarget::read(std::span<uint8_t> destination, size_t attachment) const
+{
+  const size_t bytes = _size.width * _size.height * 4;
+  if (destination.size() < bytes || attachment >= _colors.size())
+  {
+    utils::logger::error("graphics::RenderTarget - cannot read attachment {} into "
+                         "{} bytes",
+                         attachment,
+                         destination.size());
+    return;
+  }
+
+  GLint previous{0};
+  glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previous);
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, _framebuffer);
+  glReadBuffer(attachment_point(attachment));
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0,
+               0,
+               static_cast<GLsizei>(_size.width),
+               static_cast<GLsizei>(_size.height),
+               GL_RGBA,
+               GL_UNSIGNED_BYTE,
+               destination.data());
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previous));
+}
+
+unsigned int RenderTarget::get() const
+{
+  return _framebuffer;
+}
+
+unsigned int RenderTarget::colorTexture(size_t attachment) const
+{
+  return _colors.at(attachment);
+}
+
+size_t RenderTarget::colorAttachments() const
+{
+  return _colors.size();
+}
+
+gfx::Size RenderTarget::size() const
+{
+  return _size;
+}
+} // namespace gfx::graphics
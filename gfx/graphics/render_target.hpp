@@ -0,0 +1,56 @@
+#pragma once
+
+#include "vocabulary/size.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace gfx::graphics
+{
+// Framebuffer object with RGBA8 colour textures and an optional depth-stencil
+// buffer, independent of the window size. Fragment output n goes to colour
+// attachment n. The only draw target of a Window::Mode::Offscreen context.
+//
+//   RenderTarget target{gfx::Size{3840, 2160}, 2};
+//   target.bind();
+//   ...                                  // draw
+//   dump_texture("frame.png", target.colorTexture(0), 3840, 2160);
+class RenderTarget
+{
+  public:
+    explicit RenderTarget(gfx::Size size,
+                          size_t colorAttachments = 1,
+                          bool depth              = true);
+    ~RenderTarget();
+
+    RenderTarget(const RenderTarget&)            = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+    RenderTarget(RenderTarget&&)                 = delete;
+    RenderTarget& operator=(RenderTarget&&)      = delete;
+
+    // Draw and read framebuffer, viewport over the whole target
+    void bind() const;
+
+    // Back to the window, or to nothing offscreen
+    static void unbind(gfx::Size viewport);
+
+    // Every colour attachment to 'color', depth to 1 and stencil to 0
+    void clear(float red, float green, float blue, float alpha) const;
+
+    // Blocks, 'destination' holds width * height * 4 bytes, bottom row first
+    void read(std::span<uint8_t> destination, size_t attachment = 0) const;
+
+    [[nodiscard]] unsigned int get() const;
+    [[nodiscard]] unsigned int colorTexture(size_t attachment) const;
+    [[nodiscard]] size_t colorAttachments() const;
+    [[nodiscard]] gfx::Size size() const;
+
+  private:
+    gfx::Size _size;
+    unsigned int _framebuffer{0};
+    std::vector<unsigned int> _colors;
+    unsigned int _depth{0};
+};
+} // namespace gfx::graphics
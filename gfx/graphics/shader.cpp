@@ -4,20 +4,83 @@
 #include "vocabulary/color.hpp"
 
 #include <GL/glew.h>
+#include <fmt/core.h>
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace gfx::graphics
 {
+namespace
+{
+// Sorted by name, every uniform outside a block
+std::vector<std::pair<std::string, int>> active_uniforms(unsigned int program)
+{
+  int count{0};
+  int maxLength{0};
+  glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+  glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+  std::vector<std::pair<std::string, int>> locations{};
+  std::string name(static_cast<size_t>(maxLength), '\0');
+
+  for (int index = 0; index < count; ++index)
+  {
+    int length{0};
+    int size{0};
+    GLenum type{0};
+    glGetActiveUniform(program,
+                       static_cast<GLuint>(index),
+                       maxLength,
+                       &length,
+                       &size,
+                       &type,
+                       name.data());
+
+    const std::string_view active{name.data(), static_cast<size_t>(length)};
+    const int location = glGetUniformLocation(program, name.c_str());
+    if (location < 0)
+    {
+      continue;
+    }
+
+    locations.emplace_back(active, location);
+
+    // Arrays are reported once as "name[0]", also reachable as "name" and by
+    // every element
+    if (active.ends_with("[0]"))
+    {
+      const std::string_view base = active.substr(0, active.size() - 3);
+      locations.emplace_back(base, location);
+
+      for (int element = 1; element < size; ++element)
+      {
+        const std::string indexed = fmt::format("{}[{}]", base, element);
+        locations.emplace_back(indexed, glGetUniformLocation(program, indexed.c_str()));
+      }
+    }
+  }
+
+  std::ranges::sort(locations);
+  return locations;
+}
+} // namespace
+
 Shader::Shader(const char* vertex, const char* fragment)
     : _program{detail::compileShaderProgram(vertex, fragment)},
-      _colorLoc{glGetUniformLocation(_program, "uColor")},
-      _matrixLoc{glGetUniformLocation(_program, "uMatrix")}
+      _locations{active_uniforms(_program)},
+      _colorLoc{location("uColor")},
+      _matrixLoc{location("uMatrix")}
 {}
 
 Shader::Shader(const char* compute)
-    : _program{detail::compileShaderProgram(compute)}
+    : _program{detail::compileShaderProgram(compute)},
+      _locations{active_uniforms(_program)}
 {}
 
 void Shader::use() const
@@ -44,4 +107,83 @@ void Shader::setMatrixUniform(float scale) const
 
   glUniformMatrix3fv(_matrixLoc, 1, GL_FALSE, matrix.data());
 }
+
+int Shader::location(std::string_view name) const
+{
+  const auto found = std::ranges::lower_bound(_locations,
+                                              name,
+                                              std::less{},
+                                              [](const auto& uniform) {
+                                                return std::string_view{
+                                                    uniform.first};
+                                              });
+
+  if (found == _locations.end() || found->first != name)
+  {
+    return -1;
+  }
+  return found->second;
+}
+
+void Shader::setUniform(std::string_view name, int value) const
+{
+  glUniform1i(location(name), value);
+}
+
+void Shader::setUniform(std::string_view name, float value) const
+{
+  glUniform1f(location(name), value);
+}
+
+void Shader::setUniform(std::string_view name, const std::array<float, 2>& value) const
+{
+  glUniform2fv(location(name), 1, value.data());
+}
+
+void Shader::setUniform(std::string_view name, const std::array<float, 3>& value) const
+{
+  glUniform3fv(location(name), 1, value.data());
+}
+
+void Shader::setUniform(std::string_view name, const std::array<float, 4>& value) const
+{
+  glUniform4fv(location(name), 1, value.data());
+}
+
+void Shader::setUniform(std::string_view name, const std::array<float, 9>& value) const
+{
+  glUniformMatrix3fv(location(name), 1, GL_FALSE, value.data());
+}
+
+void Shader::setUniform(std::string_view name, const std::array<float, 16>& value) const
+{
+  glUniformMatrix4fv(location(name), 1, GL_FALSE, value.data());
+}
+
+size_t Shader::uniformBlockSize(std::string_view name) const
+{
+  const unsigned int index = _uniformBlockIndex(name);
+  if (index == GL_INVALID_INDEX)
+  {
+    return 0;
+  }
+
+  int size{0};
+  glGetActiveUniformBlockiv(_program, index, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+  return static_cast<size_t>(size);
+}
+
+void Shader::bindUniformBlock(std::string_view name, unsigned int binding) const
+{
+  const unsigned int index = _uniformBlockIndex(name);
+  if (index != GL_INVALID_INDEX)
+  {
+    glUniformBlockBinding(_program, index, binding);
+  }
+}
+
+unsigned int Shader::_uniformBlockIndex(std::string_view name) const
+{
+  return glGetUniformBlockIndex(_program, std::string{name}.c_str());
+}
 } // namespace gfx::graphics
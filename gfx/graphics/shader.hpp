@@ -1,5 +1,12 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 namespace gfx
 {
 class Color;
@@ -7,6 +14,10 @@ class Color;
 
 namespace gfx::graphics
 {
+// Uniform locations are queried once after linking. setUniform on a name that
+// is not an active uniform does nothing, as glUniform with location -1. The
+// program must be in use when setting uniforms. Per-frame data shared by
+// programs goes into a UniformBuffer bound with bindUniformBlock instead.
 class Shader
 {
   public:
@@ -18,9 +29,31 @@ class Shader
     void setColorUniform(const gfx::Color& color) const;
     void setMatrixUniform(float scale) const;
 
+    // -1 if 'name' is not an active uniform
+    [[nodiscard]] int location(std::string_view name) const;
+
+    void setUniform(std::string_view name, int value) const;
+    void setUniform(std::string_view name, float value) const;
+    void setUniform(std::string_view name, const std::array<float, 2>& value) const;
+    void setUniform(std::string_view name, const std::array<float, 3>& value) const;
+    void setUniform(std::string_view name, const std::array<float, 4>& value) const;
+
+    // Column major mat3 and mat4
+    void setUniform(std::string_view name, const std::array<float, 9>& value) const;
+    void setUniform(std::string_view name, const std::array<float, 16>& value) const;
+
+    // std140 size of the block in bytes, 0 if there is no such block
+    [[nodiscard]] size_t uniformBlockSize(std::string_view name) const;
+
+    // Read block 'name' from the buffer bound at 'binding', see UniformBuffer
+    void bindUniformBlock(std::string_view name, unsigned int binding) const;
+
   private:
     unsigned int _program{0};
+    std::vector<std::pair<std::string, int>> _locations;
     int _colorLoc{0};
     int _matrixLoc{0};
+
+    [[nodiscard]] unsigned int _uniformBlockIndex(std::string_view name) const;
 };
 } // namespace gfx::graphics
@@ -0,0 +1,59 @@
+#include "shared_context.hpp"
+
+#include "detail/egl_context.hpp"
+#include "utils/logger.hpp"
+
+#include <GLFW/glfw3.h>
+
+#include <memory>
+
+namespace gfx::graphics
+{
+SharedContext::SharedContext(GLFWwindow* share)
+{
+  // The context hints of the Window are still set
+  glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+  _window = glfwCreateWindow(1, 1, "shared", nullptr, share);
+
+  if (_window == nullptr)
+  {
+    utils::logger::fatal("graphics::SharedContext - could not create shared context");
+  }
+}
+
+SharedContext::SharedContext(const detail::EglContext& share)
+    : _egl{share.createShared()}
+{}
+
+SharedContext::~SharedContext()
+{
+  if (_window != nullptr)
+  {
+    glfwDestroyWindow(_window);
+  }
+}
+
+void SharedContext::makeCurrent() const
+{
+  if (_window != nullptr)
+  {
+    glfwMakeContextCurrent(_window);
+  }
+  else
+  {
+    _egl->makeCurrent();
+  }
+}
+
+void SharedContext::release() const
+{
+  if (_window != nullptr)
+  {
+    glfwMakeContextCurrent(nullptr);
+  }
+  else
+  {
+    _egl->release();
+  }
+}
+} // namespace gfx::graphics
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+
+struct GLFWwindow;
+
+namespace gfx::graphics
+{
+namespace detail
+{
+class EglContext;
+} // namespace detail
+
+// A second context sharing textures, buffers and programs with a Window, for
+// uploads and compilation on a worker thread. Vertex arrays and framebuffers
+// are not shared, create those on the thread that draws with them. Created and
+// destroyed on the thread of the Window, before the Window goes.
+//
+//   auto context = window.createSharedContext();
+//   std::thread worker{[&] { context->makeCurrent(); ...; context->release(); }};
+class SharedContext
+{
+  public:
+    // A hidden 1x1 window, GLFW contexts need one
+    explicit SharedContext(GLFWwindow* share);
+    explicit SharedContext(const detail::EglContext& share);
+    ~SharedContext();
+
+    SharedContext(const SharedContext&)            = delete;
+    SharedContext& operator=(const SharedContext&) = delete;
+    SharedContext(SharedContext&&)                 = delete;
+    SharedContext& operator=(SharedContext&&)      = delete;
+
+    // Current on the calling thread, release before the thread ends
+    void makeCurrent() const;
+    void release() const;
+
+  private:
+    GLFWwindow* _window{nullptr};
+    std::unique_ptr<detail::EglContext> _egl{};
+};
+} // namespace gfx::graphics
@@ -0,0 +1,109 @@
+#include "skyline_packer.hpp"
+
+#include "vocabulary/size.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+
+namespace gfx::graphics
+{
+SkylinePacker::SkylinePacker(gfx::Size size)
+    : _width{size.width},
+      _height{size.height}
+{
+  clear();
+}
+
+std::optional<SkylinePacker::Rect> SkylinePacker::insert(size_t width, size_t height)
+{
+  if (width == 0 || height == 0 || width > _width || height > _height)
+  {
+    return std::nullopt;
+  }
+
+  std::optional<size_t> best{};
+  size_t bestY{_height};
+
+  for (size_t index = 0; index < _skyline.size(); ++index)
+  {
+    const std::optional<size_t> y = _fit(index, width);
+    if (y && *y + height <= _height && *y < bestY)
+    {
+      best  = index;
+      bestY = *y;
+    }
+  }
+
+  if (!best)
+  {
+    return std::nullopt;
+  }
+
+  const Rect rect{_skyline[*best].x, bestY, width, height};
+
+  // The new segment covers the segments under the rectangle, the last one of
+  // them may stick out to the right
+  const size_t right = rect.x + width;
+  auto first         = std::next(_skyline.begin(), static_cast<ptrdiff_t>(*best));
+  auto last          = first;
+  while (last != _skyline.end() && last->x + last->width <= right)
+  {
+    ++last;
+  }
+  if (last != _skyline.end() && last->x < right)
+  {
+    last->width -= right - last->x;
+    last->x      = right;
+  }
+
+  first = _skyline.erase(first, last);
+  _skyline.insert(first, Segment{rect.x, rect.y + height, width});
+
+  // Neighbours at the same height are one segment
+  for (size_t index = 1; index < _skyline.size();)
+  {
+    if (_skyline[index - 1].y == _skyline[index].y)
+    {
+      _skyline[index - 1].width += _skyline[index].width;
+      _skyline.erase(std::next(_skyline.begin(), static_cast<ptrdiff_t>(index)));
+    }
+    else
+    {
+      ++index;
+    }
+  }
+
+  _used += width * height;
+  return rect;
+}
+
+void SkylinePacker::clear()
+{
+  _skyline.assign(1, Segment{0, 0, _width});
+  _used = 0;
+}
+
+double SkylinePacker::occupancy() const
+{
+  return static_cast<double>(_used) / static_cast<double>(_width * _height);
+}
+
+std::optional<size_t> SkylinePacker::_fit(size_t index, size_t width) const
+{
+  if (_skyline[index].x + width > _width)
+  {
+    return std::nullopt;
+  }
+
+  const size_t right = _skyline[index].x + width;
+
+  size_t y{0};
+  for (; index < _skyline.size() && _skyline[index].x < right; ++index)
+  {
+    y = std::max(y, _skyline[index].y);
+  }
+  return y;
+}
+} // namespace gfx::graphics
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "vocabulary/size.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace gfx::graphics
+{
+// Places rectangles in a fixed area, each on the lowest point of the outline of
+// everything placed so far, leftmost on ties. No GL, see TextureAtlas.
+class SkylinePacker
+{
+  public:
+    struct Rect
+    {
+        size_t x;
+        size_t y;
+        size_t width;
+        size_t height;
+    };
+
+    explicit SkylinePacker(gfx::Size size);
+
+    // Empty when it does not fit anywhere
+    std::optional<Rect> insert(size_t width, size_t height);
+
+    void clear();
+
+    // Area of the inserted rectangles over the whole area
+    [[nodiscard]] double occupancy() const;
+
+  private:
+    struct Segment
+    {
+        size_t x;
+        size_t y;
+        size_t width;
+    };
+
+    size_t _width;
+    size_t _height;
+    size_t _used{0};
+    std::vector<Segment> _skyline{};
+
+    // Lowest y a 'width' wide rectangle rests on starting at segment 'index'
+    [[nodiscard]] std::optional<size_t> _fit(size_t index, size_t width) const;
+};
+} // namespace gfx::graphics
@@ -0,0 +1,173 @@
+#include "streaming_texture.hpp"
+
+#include "gpu_profile.hpp"
+#include "utils/logger.hpp"
+#include "utils/profile.hpp"
+#include "vocabulary/size.hpp"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace gfx::graphics
+{
+namespace
+{
+constexpr size_t channels{4};
+
+// One second, a fence that takes longer means the context is gone
+constexpr GLuint64 fenceTimeout{1'000'000'000};
+} // namespace
+
+StreamingTexture::StreamingTexture(const gfx::Size& size, size_t depth)
+    : _size{size},
+      _frameSize{size.width * size.height * channels},
+      _slots(std::max<size_t>(depth, 1))
+{
+  constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT
+                             | GL_MAP_COHERENT_BIT;
+
+  const auto bufferSize = static_cast<GLsizeiptr>(_frameSize * _slots.size());
+
+  glGenBuffers(1, &_pbo);
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pbo);
+  glBufferStorage(GL_PIXEL_UNPACK_BUFFER, bufferSize, nullptr, flags);
+  _mapped = static_cast<uint8_t*>(
+      glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bufferSize, flags));
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+  if (_mapped == nullptr)
+  {
+    utils::logger::fatal("graphics::StreamingTexture - could not map pixel buffer");
+  }
+
+  for (Slot& slot : _slots)
+  {
+    glGenTextures(1, &slot.texture);
+    glBindTexture(GL_TEXTURE_2D, slot.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexStorage2D(GL_TEXTURE_2D,
+                   1,
+                   GL_RGBA8,
+                   static_cast<GLsizei>(_size.width),
+                   static_cast<GLsizei>(_size.height));
+  }
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+StreamingTexture::~StreamingTexture()
+{
+  for (Slot& slot : _slots)
+  {
+    glDeleteSync(slot.fence);
+    glDeleteTextures(1, &slot.texture);
+  }
+
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pbo);
+  glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  glDeleteBuffers(1, &_pbo);
+}
+
+std::span<uint8_t> StreamingTexture::acquire()
+{
+  _wait(_slots[_next]);
+  _acquired = true;
+
+  return {std::next(_mapped, static_cast<ptrdiff_t>(_next * _frameSize)), _frameSize};
+}
+
+void StreamingTexture::commit()
+{
+  static auto& zone = utils::profile::zone("StreamingTexture::commit");
+  const utils::profile::Scope scope{zone};
+
+  static auto& gpuZone = gpu_profile::zone("StreamingTexture::commit");
+  const gpu_profile::Scope gpuScope{gpuZone};
+
+  if (!_acquired)
+  {
+    utils::logger::error("graphics::StreamingTexture - commit without acquire");
+    return;
+  }
+
+  Slot& slot = _slots[_next];
+
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pbo);
+  glBindTexture(GL_TEXTURE_2D, slot.texture);
+  glTexSubImage2D(GL_TEXTURE_2D,
+                  0,
+                  0,
+                  0,
+                  static_cast<GLsizei>(_size.width),
+                  static_cast<GLsizei>(_size.height),
+                  GL_RGBA,
+                  GL_UNSIGNED_BYTE,
+                  reinterpret_cast<const void*>(_next * _frameSize)); // NOLINT
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+  // Signals once the copy out of the slot is done, the texture may still be read
+  slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+  _current  = _next;
+  _next     = (_next + 1) % _slots.size();
+  _acquired = false;
+}
+
+void StreamingTexture::upload(std::span<const uint8_t> frame)
+{
+  const std::span<uint8_t> destination = acquire();
+  std::copy_n(frame.begin(),
+              std::min(frame.size(), destination.size()),
+              destination.begin());
+  commit();
+}
+
+unsigned int StreamingTexture::get() const
+{
+  return _slots[_current].texture;
+}
+
+void StreamingTexture::bind() const
+{
+  glBindTexture(GL_TEXTURE_2D, get());
+}
+
+const gfx::Size& StreamingTexture::size() const
+{
+  return _size;
+}
+
+size_t StreamingTexture::frameSize() const
+{
+  return _frameSize;
+}
+
+size_t StreamingTexture::depth() const
+{
+  return _slots.size();
+}
+
+void StreamingTexture::_wait(Slot& slot)
+{
+  if (slot.fence == nullptr)
+  {
+    return;
+  }
+
+  const GLenum result = glClientWaitSync(slot.fence,
+                                         GL_SYNC_FLUSH_COMMANDS_BIT,
+                                         fenceTimeout);
+  if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED)
+  {
+    utils::logger::error("graphics::StreamingTexture - upload fence did not signal");
+  }
+
+  glDeleteSync(slot.fence);
+  slot.fence = nullptr;
+}
+} // namespace gfx::graphics
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "vocabulary/size.hpp"
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace gfx::graphics
+{
+// RGBA8 texture fed with CPU frames through a ring of persistently mapped pixel
+// buffers. Every slot has its own texture and fence, so the upload of frame N
+// runs while frame N-1 is drawn and the CPU only waits when it laps the GPU.
+//
+//   auto frame = texture.acquire();  // write the pixels, e.g. shmem reader
+//   texture.commit();                // queue the upload
+//   texture.bind();                  // draw the latest committed frame
+class StreamingTexture
+{
+  public:
+    explicit StreamingTexture(const gfx::Size& size, size_t depth = 3);
+    ~StreamingTexture();
+
+    StreamingTexture(const StreamingTexture&)            = delete;
+    StreamingTexture& operator=(const StreamingTexture&) = delete;
+    StreamingTexture(StreamingTexture&&)                 = delete;
+    StreamingTexture& operator=(StreamingTexture&&)      = delete;
+
+    // Mapped memory of the next slot, waits until its previous upload finished
+    [[nodiscard]] std::span<uint8_t> acquire();
+
+    // Upload the acquired slot into its texture, which becomes the current one
+    void commit();
+
+    // Same as acquire, copy and commit
+    void upload(std::span<const uint8_t> frame);
+
+    // Texture of the last committed frame
+    [[nodiscard]] unsigned int get() const;
+    void bind() const;
+
+    [[nodiscard]] const gfx::Size& size() const;
+    [[nodiscard]] size_t frameSize() const;
+    [[nodiscard]] size_t depth() const;
+
+  private:
+    struct Slot
+    {
+        unsigned int texture{0};
+        GLsync fence{nullptr};
+    };
+
+    gfx::Size _size;
+    size_t _frameSize;
+    unsigned int _pbo{0};
+    uint8_t* _mapped{nullptr};
+    std::vector<Slot> _slots;
+    size_t _next{0};
+    size_t _current{0};
+    bool _acquired{false};
+
+    void _wait(Slot& slot);
+};
+} // namespace gfx::graphics
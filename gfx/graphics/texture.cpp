@@ -1,30 +1,55 @@
 #include "texture.hpp"
 
+#include "pixel_format.hpp"
+#include "utils/logger.hpp"
+#include "vocabulary/size.hpp"
+
 #include <GL/glew.h>
 
+#include <cstddef>
+
 namespace gfx::graphics
 {
 Texture::Texture(const gfx::Size& size, void* data)
-    : Texture::Texture(size.width, size.height, data)
+    : Texture::Texture(size, PixelFormat::RGBA8, data)
 {}
 
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
 Texture::Texture(size_t width, size_t height, void* data)
-    : _size{width, height}
+    : Texture::Texture(gfx::Size{width, height}, PixelFormat::RGBA8, data)
+{}
+
+Texture::Texture(const gfx::Size& size,
+                 PixelFormat format,
+                 const void* data,
+                 bool mipmaps)
+    : _size{size},
+      _format{format},
+      _levels{mipmaps ? pixel_format::mip_levels(size) : 1}
 {
+  if (pixel_format::is_planar(_format))
+  {
+    utils::logger::fatal("graphics::Texture - planar format, use PlanarTexture");
+  }
+
   glGenTextures(1, &_texture);
   glBindTexture(GL_TEXTURE_2D, _texture);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-  glTexImage2D(GL_TEXTURE_2D,
-               0,
-               GL_RGBA8,
-               _size.width,
-               _size.height,
-               0,
-               GL_RGBA,
-               GL_UNSIGNED_BYTE,
-               data);
+  glTexParameteri(GL_TEXTURE_2D,
+                  GL_TEXTURE_MIN_FILTER,
+                  mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D,
+                  GL_TEXTURE_MAG_FILTER,
+                  mipmaps ? GL_LINEAR : GL_NEAREST);
+  glTexStorage2D(GL_TEXTURE_2D,
+                 static_cast<GLsizei>(_levels),
+                 pixel_format::describe(_format).internalFormat,
+                 _size.width,
+                 _size.height);
+
+  if (data != nullptr)
+  {
+    upload(data);
+  }
 }
 
 Texture::~Texture()
@@ -32,6 +57,38 @@ Texture::~Texture()
   glDeleteTextures(1, &_texture);
 }
 
+void Texture::upload(const void* data) const
+{
+  const pixel_format::Gl gl = pixel_format::describe(_format);
+
+  // Rows of R8 and RG8 are not 4 byte aligned for every width
+  const bool aligned = (_size.width * gl.bytesPerPixel) % 4 == 0;
+
+  glBindTexture(GL_TEXTURE_2D, _texture);
+  if (!aligned)
+  {
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  }
+  glTexSubImage2D(GL_TEXTURE_2D,
+                  0,
+                  0,
+                  0,
+                  _size.width,
+                  _size.height,
+                  gl.format,
+                  gl.type,
+                  data);
+  if (!aligned)
+  {
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  }
+
+  if (_levels > 1)
+  {
+    glGenerateMipmap(GL_TEXTURE_2D);
+  }
+}
+
 unsigned int Texture::get() const
 {
   return _texture;
@@ -41,4 +98,19 @@ void Texture::bind() const
 {
   glBindTexture(GL_TEXTURE_2D, _texture);
 }
+
+gfx::Size Texture::size() const
+{
+  return _size;
+}
+
+PixelFormat Texture::format() const
+{
+  return _format;
+}
+
+size_t Texture::levels() const
+{
+  return _levels;
+}
 } // namespace gfx::graphics
@@ -1,16 +1,26 @@
 #pragma once
 
+#include "pixel_format.hpp"
 #include "vocabulary/size.hpp"
 
 #include <cstddef>
 
 namespace gfx::graphics
 {
+// Immutable storage of one single plane PixelFormat, allocated once with
+// glTexStorage2D so uploads never make the driver reallocate. With 'mipmaps'
+// the full chain is allocated and regenerated on every upload.
 class Texture
 {
   public:
     explicit Texture(const gfx::Size& size, void* data = nullptr);
     Texture(size_t width, size_t height, void* data = nullptr);
+
+    // 'data' is tightly packed, planar formats go to PlanarTexture
+    Texture(const gfx::Size& size,
+            PixelFormat format,
+            const void* data = nullptr,
+            bool mipmaps     = false);
     ~Texture();
 
     Texture(const Texture&)           = delete;
@@ -18,11 +28,20 @@ class Texture
     Texture(Texture&&)                = delete;
     Texture operator=(Texture&&)      = delete;
 
+    // Replaces level 0, tightly packed like the constructor takes it
+    void upload(const void* data) const;
+
     [[nodiscard]] unsigned int get() const;
     void bind() const;
 
+    [[nodiscard]] gfx::Size size() const;
+    [[nodiscard]] PixelFormat format() const;
+    [[nodiscard]] size_t levels() const;
+
   private:
     gfx::Size _size;
+    PixelFormat _format;
+    size_t _levels;
     unsigned int _texture{0};
 };
 } // namespace gfx::graphics
@@ -0,0 +1,195 @@
+#include "texture_atlas.hpp"
+
+#include "skyline_packer.hpp"
+#include "utils/logger.hpp"
+#include "vocabulary/size.hpp"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace gfx::graphics
+{
+namespace
+{
+constexpr size_t channels{4};
+} // namespace
+
+TextureAtlas::TextureAtlas(gfx::Size layerSize, size_t layers, size_t border)
+    : _layerSize{layerSize},
+      _border{border},
+      _packers(std::max<size_t>(layers, 1), SkylinePacker{layerSize})
+{
+  glGenTextures(1, &_texture);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, _texture);
+  glTexStorage3D(GL_TEXTURE_2D_ARRAY,
+                 1,
+                 GL_RGBA8,
+                 static_cast<GLsizei>(_layerSize.width),
+                 static_cast<GLsizei>(_layerSize.height),
+                 static_cast<GLsizei>(_packers.size()));
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+TextureAtlas::~TextureAtlas()
+{
+  glDeleteTextures(1, &_texture);
+}
+
+std::optional<TextureAtlas::Region> TextureAtlas::add(gfx::Size size,
+                                                      std::span<const uint8_t> pixels)
+{
+  const auto width  = static_cast<size_t>(size.width);
+  const auto height = static_cast<size_t>(size.height);
+
+  if (width == 0 || height == 0)
+  {
+    utils::logger::error("graphics::TextureAtlas - empty {}x{} image", width, height);
+    return std::nullopt;
+  }
+
+  if (pixels.size() < width * height * channels)
+  {
+    utils::logger::error("graphics::TextureAtlas - {} bytes for a {}x{} image",
+                         pixels.size(),
+                         width,
+                         height);
+    return std::nullopt;
+  }
+
+  for (size_t layer = 0; layer < _packers.size(); ++layer)
+  {
+    const auto rect = _packers[layer].insert(width + 2 * _border,
+                                             height + 2 * _border);
+    if (!rect)
+    {
+      continue;
+    }
+
+    const auto layerWidth  = static_cast<float>(static_cast<size_t>(_layerSize.width));
+    const auto layerHeight = static_cast<float>(static_cast<size_t>(_layerSize.height));
+
+    const size_t x = rect->x + _border;
+    const size_t y = rect->y + _border;
+
+    const Region region{
+        .layer = layer,
+        .x     = x,
+        .y     = y,
+        .size  = size,
+        .uv    = {static_cast<float>(x) / layerWidth,
+                  static_cast<float>(y) / layerHeight,
+                  static_cast<float>(x + width) / layerWidth,
+                  static_cast<float>(y + height) / layerHeight},
+    };
+
+    _upload(region, pixels);
+    return region;
+  }
+
+  return std::nullopt;
+}
+
+void TextureAtlas::update(const Region& region, std::span<const uint8_t> pixels)
+{
+  if (pixels.size() < region.size.width * region.size.height * channels)
+  {
+    utils::logger::error("graphics::TextureAtlas - {} bytes for a {}x{} region",
+                         pixels.size(),
+                         static_cast<size_t>(region.size.width),
+                         static_cast<size_t>(region.size.height));
+    return;
+  }
+
+  _upload(region, pixels);
+}
+
+void TextureAtlas::clear()
+{
+  for (SkylinePacker& packer : _packers)
+  {
+    packer.clear();
+  }
+}
+
+unsigned int TextureAtlas::get() const
+{
+  return _texture;
+}
+
+void TextureAtlas::bind() const
+{
+  glBindTexture(GL_TEXTURE_2D_ARRAY, _texture);
+}
+
+gfx::Size TextureAtlas::layerSize() const
+{
+  return _layerSize;
+}
+
+size_t TextureAtlas::layers() const
+{
+  return _packers.size();
+}
+
+double TextureAtlas::occupancy() const
+{
+  double sum{0.0};
+  for (const SkylinePacker& packer : _packers)
+  {
+    sum += packer.occupancy();
+  }
+  return sum / static_cast<double>(_packers.size());
+}
+
+void TextureAtlas::_upload(const Region& region, std::span<const uint8_t> pixels)
+{
+  const auto width  = static_cast<size_t>(region.size.width);
+  const auto height = static_cast<size_t>(region.size.height);
+
+  const size_t paddedWidth  = width + 2 * _border;
+  const size_t paddedHeight = height + 2 * _border;
+  const size_t rowBytes     = width * channels;
+
+  // The image with its edge rows and columns repeated into the border, one
+  // upload instead of one per border strip
+  _staging.resize(paddedWidth * paddedHeight * channels);
+  for (size_t row = 0; row < paddedHeight; ++row)
+  {
+    const size_t source = std::clamp(row, _border, _border + height - 1) - _border;
+    const auto in       = pixels.subspan(source * rowBytes, rowBytes);
+    const auto out      = std::span{_staging}.subspan(row * paddedWidth * channels,
+                                                 paddedWidth * channels);
+
+    for (size_t column = 0; column < _border; ++column)
+    {
+      std::ranges::copy(in.first(channels), out.subspan(column * channels).begin());
+      std::ranges::copy(in.last(channels),
+                        out.subspan((_border + width + column) * channels).begin());
+    }
+    std::ranges::copy(in, out.subspan(_border * channels).begin());
+  }
+
+  glBindTexture(GL_TEXTURE_2D_ARRAY, _texture);
+  glTexSubImage3D(GL_TEXTURE_2D_ARRAY,
+                  0,
+                  static_cast<GLint>(region.x - _border),
+                  static_cast<GLint>(region.y - _border),
+                  static_cast<GLint>(region.layer),
+                  static_cast<GLsizei>(paddedWidth),
+                  static_cast<GLsizei>(paddedHeight),
+                  1,
+                  GL_RGBA,
+                  GL_UNSIGNED_BYTE,
+                  _staging.data());
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+} // namespace gfx::graphics
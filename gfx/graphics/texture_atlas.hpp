@@ -0,0 +1,78 @@
+#pragma once
+
+#include "skyline_packer.hpp"
+#include "vocabulary/size.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace gfx::graphics
+{
+// Many small RGBA8 images in the layers of one GL_TEXTURE_2D_ARRAY, placed by
+// a SkylinePacker per layer, so a scene binds a single texture per frame and
+// draws everything with one QuadBatch. Every image gets a border of repeated
+// edge texels so linear filtering does not bleed in from its neighbours.
+//
+//   TextureAtlas atlas{};
+//   const auto icon = atlas.add(size, pixels);  // once per image
+//   batch.add({.layer = static_cast<float>(icon->layer), .uv = icon->uv});
+//   batch.draw(atlas.get());
+class TextureAtlas
+{
+  public:
+    struct Region
+    {
+        size_t layer;
+
+        // Texels of the image without the border
+        size_t x;
+        size_t y;
+        gfx::Size size;
+
+        // u0, v0, u1, v1 of the image, v0 at its first row
+        std::array<float, 4> uv;
+    };
+
+    explicit TextureAtlas(gfx::Size layerSize = gfx::Size{2048, 2048},
+                          size_t layers       = 4,
+                          size_t border       = 1);
+    ~TextureAtlas();
+
+    TextureAtlas(const TextureAtlas&)            = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+    TextureAtlas(TextureAtlas&&)                 = delete;
+    TextureAtlas& operator=(TextureAtlas&&)      = delete;
+
+    // 'pixels' is tightly packed RGBA8 of 'size', empty when no layer has room
+    // or the image is
+    std::optional<Region> add(gfx::Size size, std::span<const uint8_t> pixels);
+
+    // Replace the image of 'region', e.g. the next frame of a video tile
+    void update(const Region& region, std::span<const uint8_t> pixels);
+
+    // Forget every region, the texels stay until they are overwritten
+    void clear();
+
+    [[nodiscard]] unsigned int get() const;
+    void bind() const;
+
+    [[nodiscard]] gfx::Size layerSize() const;
+    [[nodiscard]] size_t layers() const;
+
+    // Over all layers, see SkylinePacker::occupancy
+    [[nodiscard]] double occupancy() const;
+
+  private:
+    gfx::Size _layerSize;
+    size_t _border;
+    std::vector<SkylinePacker> _packers;
+    std::vector<uint8_t> _staging{};
+    unsigned int _texture{0};
+
+    void _upload(const Region& region, std::span<const uint8_t> pixels);
+};
+} // namespace gfx::graphics
@@ -0,0 +1,43 @@
+#include "uniform_buffer.hpp"
+
+#include <GL/glew.h>
+
+#include <cstddef>
+
+namespace gfx::graphics::detail
+{
+UniformBufferStorage::UniformBufferStorage(size_t size)
+    : _size{size}
+{
+  glGenBuffers(1, &_buffer);
+  glBindBuffer(GL_UNIFORM_BUFFER, _buffer);
+  glBufferData(GL_UNIFORM_BUFFER,
+               static_cast<GLsizeiptr>(_size),
+               nullptr,
+               GL_DYNAMIC_DRAW);
+  glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+UniformBufferStorage::~UniformBufferStorage()
+{
+  glDeleteBuffers(1, &_buffer);
+}
+
+void UniformBufferStorage::bind(unsigned int binding) const
+{
+  glBindBufferBase(GL_UNIFORM_BUFFER, binding, _buffer);
+}
+
+unsigned int UniformBufferStorage::get() const
+{
+  return _buffer;
+}
+
+void UniformBufferStorage::_write(const void* data) const
+{
+  // The driver renames the storage if the previous frame still reads it
+  glBindBuffer(GL_UNIFORM_BUFFER, _buffer);
+  glBufferSubData(GL_UNIFORM_BUFFER, 0, static_cast<GLsizeiptr>(_size), data);
+  glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+} // namespace gfx::graphics::detail
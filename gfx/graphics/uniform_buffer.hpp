@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace gfx::graphics
+{
+// Members that line up with std140 when declared in the same order as in the
+// GLSL block. Scalars in arrays take 16 bytes each in std140, use vec4 arrays.
+// A vec3 is 16 byte aligned but only 12 bytes, so a following float packs into
+// its last word. Align the member instead of the type to keep that:
+//
+//   struct Light { alignas(16) std140::vec3 position; float intensity; };
+namespace std140
+{
+struct alignas(8) vec2
+{
+    float x{0.0F};
+    float y{0.0F};
+};
+
+struct vec3
+{
+    float x{0.0F};
+    float y{0.0F};
+    float z{0.0F};
+};
+
+struct alignas(16) vec4
+{
+    float x{0.0F};
+    float y{0.0F};
+    float z{0.0F};
+    float w{0.0F};
+};
+
+// Column major, every column padded to a vec4
+struct mat3
+{
+    std::array<vec4, 3> columns{};
+};
+
+struct mat4
+{
+    std::array<vec4, 4> columns{};
+};
+} // namespace std140
+
+namespace detail
+{
+class UniformBufferStorage
+{
+  public:
+    explicit UniformBufferStorage(size_t size);
+    ~UniformBufferStorage();
+
+    UniformBufferStorage(const UniformBufferStorage&)            = delete;
+    UniformBufferStorage& operator=(const UniformBufferStorage&) = delete;
+    UniformBufferStorage(UniformBufferStorage&&)                 = delete;
+    UniformBufferStorage& operator=(UniformBufferStorage&&)      = delete;
+
+    void bind(unsigned int binding) const;
+    [[nodiscard]] unsigned int get() const;
+
+  protected:
+    void _write(const void* data) const;
+
+  private:
+    size_t _size;
+    unsigned int _buffer{0};
+};
+} // namespace detail
+
+// Per-frame data for any number of programs in one buffer write. 'Block' is a
+// struct laid out as the std140 GLSL block, compare sizeof(Block) against
+// Shader::uniformBlockSize. Every program reading it calls
+// Shader::bindUniformBlock with the same binding.
+//
+//   struct Frame { std140::mat4 transform; std140::vec4 tint; float time; };
+//   UniformBuffer<Frame> frame{};
+//   frame.bind(0);
+//   shader.bindUniformBlock("Frame", 0);
+//   frame.update({...});  // every frame
+template <typename Block>
+class UniformBuffer : public detail::UniformBufferStorage
+{
+    static_assert(std::is_trivially_copyable_v<Block>);
+
+  public:
+    UniformBuffer()
+        : detail::UniformBufferStorage{sizeof(Block)}
+    {}
+
+    void update(const Block& block) const
+    {
+      _write(&block);
+    }
+};
+} // namespace gfx::graphics
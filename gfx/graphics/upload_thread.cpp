@@ -0,0 +1,90 @@
+#include "upload_thread.hpp"
+
+#include "fence.hpp"
+#include "shared_context.hpp"
+#include "window.hpp"
+
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <utility>
+
+namespace gfx::graphics
+{
+UploadThread::UploadThread(const Window& window)
+    : _context{window.createSharedContext()},
+      _worker{[this] { _run(); }}
+{}
+
+UploadThread::~UploadThread()
+{
+  {
+    const std::scoped_lock lock{_mutex};
+    _stop = true;
+  }
+  _wake.notify_one();
+  _worker.join();
+}
+
+std::future<Fence> UploadThread::submit(Job job)
+{
+  // Orders the job after what this thread's context issued so far
+  std::packaged_task<Fence()> task{[job = std::move(job), submitted = Fence{}] {
+    submitted.wait();
+    job();
+    return Fence{};
+  }};
+  auto fence = task.get_future();
+
+  {
+    const std::scoped_lock lock{_mutex};
+    _jobs.push_back(std::move(task));
+    ++_pending;
+  }
+  _wake.notify_one();
+
+  return fence;
+}
+
+void UploadThread::wait()
+{
+  std::unique_lock lock{_mutex};
+  _idle.wait(lock, [this] { return _pending == 0; });
+}
+
+size_t UploadThread::pending() const
+{
+  const std::scoped_lock lock{_mutex};
+  return _pending;
+}
+
+void UploadThread::_run()
+{
+  _context->makeCurrent();
+
+  std::unique_lock lock{_mutex};
+  while (true)
+  {
+    _wake.wait(lock, [this] { return _stop || !_jobs.empty(); });
+    if (_jobs.empty())
+    {
+      break;
+    }
+
+    auto task = std::move(_jobs.front());
+    _jobs.pop_front();
+
+    lock.unlock();
+    task();
+    lock.lock();
+
+    if (--_pending == 0)
+    {
+      _idle.notify_all();
+    }
+  }
+  lock.unlock();
+
+  _context->release();
+}
+} // namespace gfx::graphics
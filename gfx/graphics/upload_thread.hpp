@@ -0,0 +1,70 @@
+#pragma once
+
+#include "fence.hpp"
+#include "shared_context.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace gfx::graphics
+{
+class Window;
+
+// One worker thread with a SharedContext of the Window current, so large
+// uploads, readbacks and program compilation stay off the thread that draws.
+// Fences go both ways. submit places one on the calling thread, with its
+// context current, and the worker waits on it before the job, so objects that
+// thread created or changed before submit are complete for the job. Each job
+// is followed by a Fence too, the render thread waits on it before its first
+// use of what the job wrote. Goes before the Window does.
+//
+//   UploadThread uploads{window};
+//   auto uploaded = uploads.submit([&] { texture.upload(pixels.data()); });
+//   ...
+//   uploaded.get().wait();  // once ready, the GPU waits and the CPU does not
+//   texture.bind();
+class UploadThread
+{
+  public:
+    using Job = std::function<void()>;
+
+    explicit UploadThread(const Window& window);
+
+    // Runs the jobs still queued
+    ~UploadThread();
+
+    UploadThread(const UploadThread&)            = delete;
+    UploadThread& operator=(const UploadThread&) = delete;
+    UploadThread(UploadThread&&)                 = delete;
+    UploadThread& operator=(UploadThread&&)      = delete;
+
+    // On a thread with a context of the Window current. Jobs run in order, an
+    // exception thrown by 'job' comes out of get()
+    [[nodiscard]] std::future<Fence> submit(Job job);
+
+    // Block until every submitted job has run
+    void wait();
+
+    [[nodiscard]] size_t pending() const;
+
+  private:
+    std::unique_ptr<SharedContext> _context;
+
+    mutable std::mutex _mutex{};
+    std::condition_variable _wake{};
+    std::condition_variable _idle{};
+    std::deque<std::packaged_task<Fence()>> _jobs{};
+    size_t _pending{0};
+    bool _stop{false};
+
+    std::thread _worker;
+
+    void _run();
+};
+} // namespace gfx::graphics
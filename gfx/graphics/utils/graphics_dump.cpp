@@ -1,12 +1,13 @@
 #include "graphics_dump.hpp"
 
-#include "utils/logger.hpp"
+#include "utils/image_sink.hpp"
+#include "utils/profile.hpp"
+#include "vocabulary/size.hpp"
 
 #include <GL/glew.h>
 
-#include <stb_image_write.h>
-
 #include <cstddef>
+#include <cstdint>
 #include <string_view>
 #include <vector>
 
@@ -16,31 +17,23 @@ namespace gfx::utils
 void dump_texture(std::string_view filename,
                   unsigned int texture,
                   size_t width,
-                  size_t height)
+                  size_t height,
+                  ThreadPool* pool)
 // NOLINTEND(bugprone-easily-swappable-parameters)
 {
+  static auto& zone = profile::zone("dump_texture");
+  const profile::Scope scope{zone};
+
   glBindTexture(GL_TEXTURE_2D, texture);
-  std::vector<unsigned char> buffer{};
+  std::vector<uint8_t> buffer{};
   constexpr unsigned int channels{4};
   buffer.resize(width * height * channels);
   glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, buffer.data());
   glBindTexture(GL_TEXTURE_2D, 0);
 
-  stbi_flip_vertically_on_write(static_cast<int>(true));
-
-  if (filename.ends_with(".jpg"))
-  {
-    static const int quality{100};
-    stbi_write_jpg(filename.data(),
-                   static_cast<int>(width),
-                   static_cast<int>(height),
-                   channels,
-                   buffer.data(),
-                   quality);
-  }
-  else
-  {
-    logger::fatal("did not recognize extension for ", filename);
-  }
+  // glGetTexImage returns the bottom row first
+  image::write(filename,
+               {buffer, gfx::Size{width, height}, channels, true},
+               {.pool = pool});
 }
 } // namespace gfx::utils
@@ -5,8 +5,13 @@
 
 namespace gfx::utils
 {
+class ThreadPool;
+
+// Blocking, the extension picks the encoder, see utils/image_sink.hpp. The rows
+// are encoded on 'pool' when given, one the caller does not run on.
 void dump_texture(std::string_view filename,
                   unsigned int texture,
                   size_t width,
-                  size_t height);
+                  size_t height,
+                  ThreadPool* pool = nullptr);
 } // namespace gfx::utils
@@ -0,0 +1,177 @@
+#include "texture_readback.hpp"
+
+#include "utils/image_sink.hpp"
+#include "utils/logger.hpp"
+#include "utils/profile.hpp"
+#include "vocabulary/size.hpp"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gfx::utils
+{
+namespace
+{
+constexpr size_t channels{4};
+
+// One second, a fence that takes longer means the context is gone
+constexpr GLuint64 fenceTimeout{1'000'000'000};
+} // namespace
+
+TextureReadback::TextureReadback(const gfx::Size& size,
+                                 size_t depth,
+                                 size_t threads,
+                                 ThreadPool* rowPool)
+    : _size{size},
+      _frameSize{size.width * size.height * channels},
+      _slots(std::max<size_t>(depth, 1)),
+      _pool{threads},
+      _rowPool{rowPool}
+{
+  glGenFramebuffers(1, &_framebuffer);
+
+  for (Slot& slot : _slots)
+  {
+    glGenBuffers(1, &slot.pbo);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    glBufferData(GL_PIXEL_PACK_BUFFER,
+                 static_cast<GLsizeiptr>(_frameSize),
+                 nullptr,
+                 GL_STREAM_READ);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+TextureReadback::~TextureReadback()
+{
+  flush();
+
+  for (Slot& slot : _slots)
+  {
+    glDeleteBuffers(1, &slot.pbo);
+  }
+  glDeleteFramebuffers(1, &_framebuffer);
+}
+
+void TextureReadback::dump(std::string filename, unsigned int texture)
+{
+  static auto& zone = profile::zone("TextureReadback::dump");
+  const profile::Scope scope{zone};
+
+  // Hand over whatever finished already, oldest first
+  for (size_t index = 0; index < _slots.size(); ++index)
+  {
+    _collect(_slots[(_next + index) % _slots.size()], false);
+  }
+
+  Slot& slot = _slots[_next];
+  _collect(slot, true);
+
+  GLint previous{0};
+  glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previous);
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, _framebuffer);
+  glFramebufferTexture2D(GL_READ_FRAMEBUFFER,
+                         GL_COLOR_ATTACHMENT0,
+                         GL_TEXTURE_2D,
+                         texture,
+                         0);
+  glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+  glReadPixels(0,
+               0,
+               static_cast<GLsizei>(_size.width),
+               static_cast<GLsizei>(_size.height),
+               GL_RGBA,
+               GL_UNSIGNED_BYTE,
+               nullptr);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previous));
+
+  slot.fence    = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  slot.filename = std::move(filename);
+
+  _next = (_next + 1) % _slots.size();
+}
+
+void TextureReadback::flush()
+{
+  for (size_t index = 0; index < _slots.size(); ++index)
+  {
+    _collect(_slots[(_next + index) % _slots.size()], true);
+  }
+  _pool.wait();
+}
+
+size_t TextureReadback::failed() const
+{
+  return _failed.load(std::memory_order_relaxed);
+}
+
+void TextureReadback::_collect(Slot& slot, bool block)
+{
+  if (slot.fence == nullptr)
+  {
+    return;
+  }
+
+  const GLenum result = glClientWaitSync(slot.fence,
+                                         GL_SYNC_FLUSH_COMMANDS_BIT,
+                                         block ? fenceTimeout : 0);
+  if (result == GL_TIMEOUT_EXPIRED && !block)
+  {
+    return;
+  }
+
+  glDeleteSync(slot.fence);
+  slot.fence = nullptr;
+
+  if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED)
+  {
+    logger::error("TextureReadback - readback for {} did not finish", slot.filename);
+    _failed.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  // One copy out of the mapping, the slot is free again right after
+  auto pixels = std::make_shared<std::vector<uint8_t>>(_frameSize);
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+  const auto* mapped = static_cast<const uint8_t*>(
+      glMapBufferRange(GL_PIXEL_PACK_BUFFER,
+                       0,
+                       static_cast<GLsizeiptr>(_frameSize),
+                       GL_MAP_READ_BIT));
+  if (mapped != nullptr)
+  {
+    std::copy_n(mapped, _frameSize, pixels->begin());
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  if (mapped == nullptr)
+  {
+    logger::error("TextureReadback - could not map readback for {}", slot.filename);
+    _failed.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  // glReadPixels returns the bottom row first
+  _pool.submit([this, pixels, filename = std::move(slot.filename)] {
+    if (!image::write(filename, {*pixels, _size, channels, true}, {.pool = _rowPool}))
+    {
+      _failed.fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+}
+} // namespace gfx::utils
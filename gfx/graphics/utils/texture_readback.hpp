@@ -0,0 +1,66 @@
+#pragma once
+
+#include "utils/thread_pool.hpp"
+#include "vocabulary/size.hpp"
+
+#include <GL/glew.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gfx::utils
+{
+// Non-blocking counterpart of dump_texture for dumping every frame. dump queues
+// glReadPixels into a pixel buffer with a fence and returns, the bytes are mapped
+// once the fence signalled, at the latest 'depth' dumps later, and a worker
+// encodes them, the extension picks the format, see utils/image_sink.hpp.
+// 'rowPool' splits the rows of each file as well, a pool other than the
+// readback's own workers.
+class TextureReadback
+{
+  public:
+    explicit TextureReadback(const gfx::Size& size,
+                             size_t depth        = 3,
+                             size_t threads      = 2,
+                             ThreadPool* rowPool = nullptr);
+
+    // Writes out everything still in flight
+    ~TextureReadback();
+
+    TextureReadback(const TextureReadback&)            = delete;
+    TextureReadback& operator=(const TextureReadback&) = delete;
+    TextureReadback(TextureReadback&&)                 = delete;
+    TextureReadback& operator=(TextureReadback&&)      = delete;
+
+    // 'texture' is RGBA8 of the constructed size
+    void dump(std::string filename, unsigned int texture);
+
+    // Map every pending readback and wait until all files are written
+    void flush();
+
+    // Dumps that could not be encoded or written
+    [[nodiscard]] size_t failed() const;
+
+  private:
+    struct Slot
+    {
+        unsigned int pbo{0};
+        GLsync fence{nullptr};
+        std::string filename{};
+    };
+
+    gfx::Size _size;
+    size_t _frameSize;
+    unsigned int _framebuffer{0};
+    std::vector<Slot> _slots;
+    size_t _next{0};
+    std::atomic<size_t> _failed{0};
+    ThreadPool _pool;
+    ThreadPool* _rowPool;
+
+    void _collect(Slot& slot, bool block);
+};
+} // namespace gfx::utils
@@ -1,12 +1,21 @@
 #include "window.hpp"
 
+#include "detail/egl_context.hpp"
+#include "gpu_profile.hpp"
+#include "shared_context.hpp"
 #include "utils/logger.hpp"
+#include "utils/trace.hpp"
 
 #include <GL/glew.h>
 
 #include <GLFW/glfw3.h>
 
+#include <chrono>
+#include <cstddef>
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <string_view>
 
 namespace gfx::graphics
 {
@@ -17,89 +26,108 @@ void glfw_error_callback(int /*error*/, const char* description)
   std::cout << "gfx::window: " << description << '\n';
 }
 
-// NOLINTNEXTLINE
-void APIENTRY opengl_debug_callback(GLenum source,
-                                    GLenum type,
-                                    unsigned int message_id,
-                                    GLenum severity,
-                                    GLsizei /*length*/,
-                                    const char* message,
-                                    const void* /*userParam*/)
+std::string_view debug_source(GLenum source)
 {
-  std::cout << "-------opengl_debug_callback--------" << '\n';
-  std::cout << "Debug message (" << message_id << "): " << message << '\n';
-
   switch (source)
   {
   case GL_DEBUG_SOURCE_API:
-    std::cout << "Source: API";
-    break;
+    return "API";
   case GL_DEBUG_SOURCE_WINDOW_SYSTEM:
-    std::cout << "Source: Window System";
-    break;
+    return "Window System";
   case GL_DEBUG_SOURCE_SHADER_COMPILER:
-    std::cout << "Source: Shader Compiler";
-    break;
+    return "Shader Compiler";
   case GL_DEBUG_SOURCE_THIRD_PARTY:
-    std::cout << "Source: Third Party";
-    break;
+    return "Third Party";
   case GL_DEBUG_SOURCE_APPLICATION:
-    std::cout << "Source: Application";
-    break;
-  case GL_DEBUG_SOURCE_OTHER:
-    std::cout << "Source: Other";
-    break;
+    return "Application";
+  default:
+    return "Other";
   }
-  std::cout << '\n';
+}
 
+std::string_view debug_type(GLenum type)
+{
   switch (type)
   {
   case GL_DEBUG_TYPE_ERROR:
-    std::cout << "Type: Error";
-    break;
+    return "Error";
   case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR:
-    std::cout << "Type: Deprecated Behaviour";
-    break;
+    return "Deprecated Behaviour";
   case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:
-    std::cout << "Type: Undefined Behaviour";
-    break;
+    return "Undefined Behaviour";
   case GL_DEBUG_TYPE_PORTABILITY:
-    std::cout << "Type: Portability";
-    break;
+    return "Portability";
   case GL_DEBUG_TYPE_PERFORMANCE:
-    std::cout << "Type: Performance";
-    break;
+    return "Performance";
   case GL_DEBUG_TYPE_MARKER:
-    std::cout << "Type: Marker";
-    break;
+    return "Marker";
   case GL_DEBUG_TYPE_PUSH_GROUP:
-    std::cout << "Type: Push Group";
-    break;
+    return "Push Group";
   case GL_DEBUG_TYPE_POP_GROUP:
-    std::cout << "Type: Pop Group";
-    break;
-  case GL_DEBUG_TYPE_OTHER:
-    std::cout << "Type: Other";
-    break;
+    return "Pop Group";
+  default:
+    return "Other";
   }
-  std::cout << '\n';
+}
+
+// The driver reports the same message for every offending call, repeats are
+// counted instead of written
+// NOLINTNEXTLINE
+void APIENTRY opengl_debug_callback(GLenum source,
+                                    GLenum type,
+                                    unsigned int message_id,
+                                    GLenum severity,
+                                    GLsizei /*length*/,
+                                    const char* message,
+                                    const void* /*userParam*/)
+{
+  static utils::logger::Deduplicate site{};
+
+  constexpr std::string_view format = "OpenGL {} {} ({}): {}";
 
   switch (severity)
   {
   case GL_DEBUG_SEVERITY_HIGH:
-    std::cout << "Severity: high";
+    utils::logger::error(site,
+                         format,
+                         debug_source(source),
+                         debug_type(type),
+                         message_id,
+                         message);
     break;
   case GL_DEBUG_SEVERITY_MEDIUM:
-    std::cout << "Severity: medium";
-    break;
   case GL_DEBUG_SEVERITY_LOW:
-    std::cout << "Severity: low";
+    utils::logger::warning(site,
+                           format,
+                           debug_source(source),
+                           debug_type(type),
+                           message_id,
+                           message);
     break;
-  case GL_DEBUG_SEVERITY_NOTIFICATION:
-    std::cout << "Severity: notification";
+  default:
+    utils::logger::info(site,
+                        format,
+                        debug_source(source),
+                        debug_type(type),
+                        message_id,
+                        message);
     break;
   }
-  std::cout << "\n\n";
+}
+
+constexpr size_t frameStatsCapacity{600};
+
+// Unknown without a monitor, e.g. headless
+std::optional<std::chrono::nanoseconds> refresh_period()
+{
+  GLFWmonitor* monitor    = glfwGetPrimaryMonitor();
+  const GLFWvidmode* mode = monitor != nullptr ? glfwGetVideoMode(monitor) : nullptr;
+  if (mode == nullptr || mode->refreshRate <= 0)
+  {
+    return std::nullopt;
+  }
+
+  return std::chrono::nanoseconds{std::chrono::seconds{1}} / mode->refreshRate;
 }
 
 struct OpenglVersion
@@ -135,7 +163,7 @@ void initialize_glfw(Window::Mode mode)
   }
 }
 
-void initialize_opengl()
+void initialize_opengl(Window::Mode mode)
 {
   glewExperimental = GL_TRUE;
   glewInit();
@@ -157,7 +185,12 @@ void initialize_opengl()
   }
 
   glClearColor(1.0F, 1.0F, 0.0F, 1.0F);
-  glClear(GL_COLOR_BUFFER_BIT);
+
+  // Offscreen there is no default framebuffer to clear
+  if (mode != Window::Mode::Offscreen)
+  {
+    glClear(GL_COLOR_BUFFER_BIT);
+  }
 
   glEnable(GL_BLEND);
   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -186,19 +219,44 @@ GLFWwindow* create_window_glfw(const char* name,
                                  });
   // NOLINTEND(bugprone-easily-swappable-parameters)
 
-  initialize_opengl();
+  initialize_opengl(mode);
 
   return window;
 }
 
+GLint draw_framebuffer()
+{
+  GLint framebuffer{0};
+  glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+  return framebuffer;
+}
+
+std::unique_ptr<detail::EglContext> create_context_egl()
+{
+  auto context = std::make_unique<detail::EglContext>(OpenglVersion::major,
+                                                      OpenglVersion::minor);
+  initialize_opengl(Window::Mode::Offscreen);
+  return context;
+}
+
 } // namespace
 
 Window::Window(const char* name, const gfx::Size& size, Mode mode)
-    : _window{create_window_glfw(name, size, mode)}
+    : _window{mode == Mode::Offscreen ? nullptr : create_window_glfw(name, size, mode)},
+      _offscreen{mode == Mode::Offscreen ? create_context_egl() : nullptr},
+      _frameStats{frameStatsCapacity,
+                  mode == Mode::Offscreen ? std::nullopt : refresh_period()}
 {}
 
 Window::~Window()
 {
+  _gpuFrame.reset();
+
+  if (_window == nullptr)
+  {
+    return;
+  }
+
   glfwMakeContextCurrent(nullptr);
   glfwDestroyWindow(_window);
   glfwTerminate();
@@ -206,17 +264,107 @@ Window::~Window()
 
 void Window::swap()
 {
-  if (glfwGetKey(_window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+  static const utils::trace::EventId swapped = utils::trace::event("swap");
+  const utils::trace::Scope scope{swapped};
+
+  if (_window != nullptr && glfwGetKey(_window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
   {
     glfwSetWindowShouldClose(_window, GLFW_TRUE);
   }
-  glfwSwapBuffers(_window);
-  glfwPollEvents();
-  glClear(GL_COLOR_BUFFER_BIT);
+
+  _gpuFrame.reset();
+
+  const auto swapStart = Clock::now();
+  if (_window != nullptr)
+  {
+    glfwSwapBuffers(_window);
+  }
+  else
+  {
+    glFlush();
+  }
+  const auto swapEnd = Clock::now();
+
+  // The first frame has no interval, it would only measure setup
+  if (_lastSwap != Clock::time_point{})
+  {
+    _frameStats.add({
+        .cpu      = swapStart - _frameStart,
+        .swap     = swapEnd - swapStart,
+        .interval = swapEnd - _lastSwap,
+    });
+  }
+  _lastSwap = swapEnd;
+
+  if (_reportInterval.count() != 0 && swapEnd - _lastReport >= _reportInterval)
+  {
+    _report(swapEnd);
+  }
+
+  if (_window != nullptr)
+  {
+    glfwPollEvents();
+    glClear(GL_COLOR_BUFFER_BIT);
+  }
+  else if (draw_framebuffer() != 0)
+  {
+    // Offscreen the bound RenderTarget takes the place of the back buffer
+    glClear(GL_COLOR_BUFFER_BIT);
+  }
+
+  gpu_profile::collect();
+
+  static auto& gpuZone = gpu_profile::zone("frame");
+  _gpuFrame.emplace(gpuZone);
+
+  _frameStart = Clock::now();
 }
 
 bool Window::isOpen() const
 {
-  return glfwWindowShouldClose(_window) == GLFW_FALSE;
+  return _window == nullptr || glfwWindowShouldClose(_window) == GLFW_FALSE;
+}
+
+const FrameStats& Window::frameStats() const
+{
+  return _frameStats;
+}
+
+void Window::reportFrameStats(std::chrono::milliseconds interval)
+{
+  _reportInterval = interval;
+  _lastReport     = Clock::now();
+}
+
+std::unique_ptr<SharedContext> Window::createSharedContext() const
+{
+  if (_window != nullptr)
+  {
+    return std::make_unique<SharedContext>(_window);
+  }
+  return std::make_unique<SharedContext>(*_offscreen);
+}
+
+void Window::_report(Clock::time_point now)
+{
+  const FrameStats::Summary summary = _frameStats.summary();
+
+  utils::logger::info("frames {} ({:.1f} fps), {} missed, interval p50 {:.2f} ms "
+                      "p99 {:.2f} ms max {:.2f} ms",
+                      summary.frames,
+                      summary.fps,
+                      summary.missed,
+                      summary.interval.p50,
+                      summary.interval.p99,
+                      summary.interval.max);
+  utils::logger::info("cpu p50 {:.2f} ms p99 {:.2f} ms, swap wait p50 {:.2f} ms "
+                      "p99 {:.2f} ms",
+                      summary.cpu.p50,
+                      summary.cpu.p99,
+                      summary.swap.p50,
+                      summary.swap.p99);
+
+  _frameStats.clear();
+  _lastReport = now;
 }
 } // namespace gfx::graphics
@@ -1,17 +1,34 @@
 #pragma once
 
+#include "graphics/frame_stats.hpp"
+#include "graphics/gpu_profile.hpp"
 #include "vocabulary/size.hpp"
 
 #include <GL/glew.h>
 
 #include <GLFW/glfw3.h>
 
+#include <chrono>
+#include <memory>
+#include <optional>
+
 namespace gfx::graphics
 {
+namespace detail
+{
+class EglContext;
+} // namespace detail
+
+class SharedContext;
+
+// Headless is a hidden window and still needs a display server. Offscreen is a
+// surfaceless EGL context without a default framebuffer, draw into a
+// RenderTarget of any size instead.
 enum class WindowMode
 {
   Windowed,
-  Headless
+  Headless,
+  Offscreen
 };
 
 class Window
@@ -25,10 +42,37 @@ class Window
     Window(Window&&)                 = delete;
     Window& operator=(Window&&)      = delete;
 
+    // Offscreen only flushes and records the frame timings
     void swap();
+
+    // Always true offscreen, the caller decides when it is done
     [[nodiscard]] bool isOpen() const;
 
+    // Timings of the recent frames, see FrameStats
+    [[nodiscard]] const FrameStats& frameStats() const;
+
+    // Log the frame summary every 'interval' from swap and start the statistics
+    // over, zero turns it off
+    void reportFrameStats(std::chrono::milliseconds interval);
+
+    // For a worker thread, see SharedContext and UploadThread
+    [[nodiscard]] std::unique_ptr<SharedContext> createSharedContext() const;
+
   private:
-    GLFWwindow* _window;
+    using Clock = std::chrono::steady_clock;
+
+    GLFWwindow* _window{nullptr};
+    std::unique_ptr<detail::EglContext> _offscreen;
+
+    FrameStats _frameStats;
+    Clock::time_point _frameStart{Clock::now()};
+    Clock::time_point _lastSwap{};
+    std::chrono::milliseconds _reportInterval{0};
+    Clock::time_point _lastReport{};
+
+    // GPU time from one swap to the next, "frame (gpu)" in the profile summary
+    std::optional<gpu_profile::Scope> _gpuFrame{};
+
+    void _report(Clock::time_point now);
 };
 } // namespace gfx::graphics
@@ -0,0 +1,182 @@
+#include "yuv_converter.hpp"
+
+#include "detail/ycbcr.hpp"
+#include "gpu_profile.hpp"
+#include "shader.hpp"
+#include "shaders/rgb_to_yuv.hpp"
+#include "utils/logger.hpp"
+#include "utils/profile.hpp"
+#include "vocabulary/size.hpp"
+
+#include <GL/glew.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace gfx::graphics
+{
+namespace
+{
+// Pixels per invocation and invocations per work group, see rgb_to_yuv.compute
+constexpr size_t blockWidth{8};
+constexpr size_t blockHeight{2};
+constexpr size_t groupSide{16};
+
+// Column major, R'G'B' in [0, 1] to code values, offsets separately
+std::array<float, 9> conversion(YuvConverter::Matrix matrix, YuvConverter::Range range)
+{
+  const auto [kr, kb] = detail::luma_coefficients(matrix);
+  const float kg      = 1.0F - kr - kb;
+
+  const bool full         = range == YuvConverter::Range::Full;
+  const float lumaScale   = full ? 255.0F : 219.0F;
+  const float chromaScale = full ? 255.0F : 224.0F;
+
+  // Pb and Pr span [-0.5, 0.5]
+  const float cb = chromaScale / (2.0F * (1.0F - kb));
+  const float cr = chromaScale / (2.0F * (1.0F - kr));
+
+  return {lumaScale * kr,
+          -cb * kr,
+          cr * (1.0F - kr),
+          lumaScale * kg,
+          -cb * kg,
+          -cr * kg,
+          lumaScale * kb,
+          cb * (1.0F - kb),
+          -cr * kb};
+}
+
+std::array<float, 3> offsets(YuvConverter::Range range)
+{
+  const float luma = range == YuvConverter::Range::Full ? 0.0F : 16.0F;
+  return {luma, 128.0F, 128.0F};
+}
+
+size_t groups(size_t pixels, size_t perGroup)
+{
+  return (pixels + perGroup - 1) / perGroup;
+}
+} // namespace
+
+YuvConverter::YuvConverter(gfx::Size size, Layout layout, Matrix matrix, Range range)
+    : _shader{shaders::RgbToYuv::compute},
+      _size{size},
+      _layout{layout}
+{
+  const auto width  = static_cast<size_t>(_size.width);
+  const auto height = static_cast<size_t>(_size.height);
+
+  if (width % blockWidth != 0 || height % blockHeight != 0)
+  {
+    utils::logger::fatal("graphics::YuvConverter - {}x{} is not a multiple of {}x{}",
+                         width,
+                         height,
+                         blockWidth,
+                         blockHeight);
+  }
+
+  const size_t lumaSize = width * height;
+  _planes[0]            = {0, lumaSize, width};
+
+  if (_layout == Layout::NV12)
+  {
+    _planes[1]  = {lumaSize, lumaSize / 2, width};
+    _planeCount = 2;
+  }
+  else
+  {
+    _planes[1]  = {lumaSize, lumaSize / 4, width / 2};
+    _planes[2]  = {lumaSize + lumaSize / 4, lumaSize / 4, width / 2};
+    _planeCount = 3;
+  }
+
+  glGenBuffers(1, &_buffer);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, _buffer);
+  glBufferData(GL_SHADER_STORAGE_BUFFER,
+               static_cast<GLsizeiptr>(frameSize()),
+               nullptr,
+               GL_STREAM_READ);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+  _shader.use();
+  _shader.setUniform("uMatrix", conversion(matrix, range));
+  _shader.setUniform("uOffset", offsets(range));
+  _shader.setUniform("uWidth", static_cast<int>(width));
+  _shader.setUniform("uHeight", static_cast<int>(height));
+  _shader.setUniform("uInterleaved", _layout == Layout::NV12 ? 1 : 0);
+}
+
+YuvConverter::~YuvConverter()
+{
+  glDeleteBuffers(1, &_buffer);
+}
+
+void YuvConverter::convert(unsigned int texture, bool flip) const
+{
+  static auto& zone = utils::profile::zone("YuvConverter::convert");
+  const utils::profile::Scope scope{zone};
+
+  static auto& gpuZone = gpu_profile::zone("YuvConverter::convert");
+  const gpu_profile::Scope gpuScope{gpuZone};
+
+  _shader.use();
+  _shader.setUniform("uFlip", flip ? 1 : 0);
+
+  glBindImageTexture(0, texture, 0, GL_FALSE, 0, GL_READ_ONLY, GL_RGBA8);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, _buffer);
+
+  glDispatchCompute(
+      static_cast<GLuint>(groups(_size.width, blockWidth * groupSide)),
+      static_cast<GLuint>(groups(_size.height, blockHeight * groupSide)),
+      1);
+
+  // Covers reading the planes back and copying them to a pixel buffer
+  glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT | GL_PIXEL_BUFFER_BARRIER_BIT);
+}
+
+void YuvConverter::read(std::span<uint8_t> destination) const
+{
+  if (destination.size() < frameSize())
+  {
+    utils::logger::error("graphics::YuvConverter - {} bytes do not hold a frame of {}",
+                         destination.size(),
+                         frameSize());
+    return;
+  }
+
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, _buffer);
+  glGetBufferSubData(GL_SHADER_STORAGE_BUFFER,
+                     0,
+                     static_cast<GLsizeiptr>(frameSize()),
+                     destination.data());
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+unsigned int YuvConverter::buffer() const
+{
+  return _buffer;
+}
+
+size_t YuvConverter::frameSize() const
+{
+  return _size.width * _size.height * 3 / 2;
+}
+
+std::span<const YuvConverter::Plane> YuvConverter::planes() const
+{
+  return {_planes.data(), _planeCount};
+}
+
+gfx::Size YuvConverter::size() const
+{
+  return _size;
+}
+
+YuvConverter::Layout YuvConverter::layout() const
+{
+  return _layout;
+}
+} // namespace gfx::graphics
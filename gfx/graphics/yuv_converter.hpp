@@ -0,0 +1,87 @@
+#pragma once
+
+#include "shader.hpp"
+#include "vocabulary/size.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace gfx::graphics
+{
+// Converts an RGBA8 texture to 4:2:0 Y'CbCr on the GPU, written into one buffer
+// object with the planes back to back, the raw frame layout the muxer takes as
+// AV_PIX_FMT_NV12 or AV_PIX_FMT_YUV420P. Chroma is the average of each 2x2
+// block. The width must be a multiple of 8 and the height even.
+//
+//   YuvConverter converter{size, YuvConverter::Layout::I420};
+//   converter.convert(texture);  // every frame
+//   converter.read(frame);       // or copy from converter.buffer()
+class YuvConverter
+{
+  public:
+    enum class Layout
+    {
+      NV12,
+      I420
+    };
+
+    enum class Matrix
+    {
+      BT601,
+      BT709
+    };
+
+    // Limited is 16-235 luma and 16-240 chroma, what most encoders expect
+    enum class Range
+    {
+      Limited,
+      Full
+    };
+
+    struct Plane
+    {
+        size_t offset;
+        size_t size;
+        size_t stride;
+    };
+
+    explicit YuvConverter(gfx::Size size,
+                          Layout layout = Layout::I420,
+                          Matrix matrix = Matrix::BT709,
+                          Range range   = Range::Limited);
+    ~YuvConverter();
+
+    YuvConverter(const YuvConverter&)            = delete;
+    YuvConverter& operator=(const YuvConverter&) = delete;
+    YuvConverter(YuvConverter&&)                 = delete;
+    YuvConverter& operator=(YuvConverter&&)      = delete;
+
+    // 'texture' is a GL_RGBA8 texture of 'size', 'flip' for textures that were
+    // rendered to, row 0 of the output is the top row. Returns before the GPU
+    // is done, buffer reads issued after it see the result.
+    void convert(unsigned int texture, bool flip = false) const;
+
+    // Blocks until the conversion is done, 'destination' holds frameSize bytes
+    void read(std::span<uint8_t> destination) const;
+
+    // GL_SHADER_STORAGE_BUFFER with frameSize bytes
+    [[nodiscard]] unsigned int buffer() const;
+    [[nodiscard]] size_t frameSize() const;
+
+    // Y, then Cb and Cr for I420 or CbCr for NV12
+    [[nodiscard]] std::span<const Plane> planes() const;
+
+    [[nodiscard]] gfx::Size size() const;
+    [[nodiscard]] Layout layout() const;
+
+  private:
+    Shader _shader;
+    gfx::Size _size;
+    Layout _layout;
+    std::array<Plane, 3> _planes{};
+    size_t _planeCount{0};
+    unsigned int _buffer{0};
+};
+} // namespace gfx::graphics
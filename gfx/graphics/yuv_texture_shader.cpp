@@ -0,0 +1,98 @@
+#include "yuv_texture_shader.hpp"
+
+#include "detail/ycbcr.hpp"
+#include "pixel_format.hpp"
+#include "planar_texture.hpp"
+#include "shader.hpp"
+#include "shaders/texture.hpp"
+#include "shaders/yuv_texture.hpp"
+#include "utils/logger.hpp"
+
+#include <array>
+
+namespace gfx::graphics
+{
+namespace
+{
+// Column major, normalized code values minus the offsets to R'G'B' in [0, 1],
+// the inverse of what rgb_to_yuv.compute applies
+std::array<float, 9> conversion(YuvTextureShader::Matrix matrix,
+                                YuvTextureShader::Range range)
+{
+  const auto [kr, kb] = detail::luma_coefficients(matrix);
+  const float kg      = 1.0F - kr - kb;
+
+  const bool full         = range == YuvTextureShader::Range::Full;
+  const float lumaScale   = full ? 1.0F : 255.0F / 219.0F;
+  const float chromaScale = full ? 1.0F : 255.0F / 224.0F;
+
+  // Pb and Pr span [-0.5, 0.5]
+  const float blueFromCb  = 2.0F * (1.0F - kb) * chromaScale;
+  const float redFromCr   = 2.0F * (1.0F - kr) * chromaScale;
+  const float greenFromCb = -2.0F * kb * (1.0F - kb) / kg * chromaScale;
+  const float greenFromCr = -2.0F * kr * (1.0F - kr) / kg * chromaScale;
+
+  return {lumaScale,
+          lumaScale,
+          lumaScale,
+          0.0F,
+          greenFromCb,
+          blueFromCb,
+          redFromCr,
+          greenFromCr,
+          0.0F};
+}
+
+std::array<float, 3> offsets(YuvTextureShader::Range range)
+{
+  const float luma = range == YuvTextureShader::Range::Full ? 0.0F : 16.0F;
+  return {luma / 255.0F, 128.0F / 255.0F, 128.0F / 255.0F};
+}
+} // namespace
+
+YuvTextureShader::YuvTextureShader(PixelFormat format, Matrix matrix, Range range)
+    : _shader{shaders::Texture::vertex, shaders::YuvTexture::fragment},
+      _format{format}
+{
+  if (!pixel_format::is_planar(format))
+  {
+    utils::logger::fatal("graphics::YuvTextureShader - not a planar YUV format");
+  }
+
+  _shader.use();
+  _shader.setUniform("uLuma", 0);
+  _shader.setUniform("uChromaBlue", 1);
+  _shader.setUniform("uChromaRed", 2);
+  _shader.setUniform("uInterleaved", format == PixelFormat::NV12 ? 1 : 0);
+  setColorimetry(matrix, range);
+}
+
+void YuvTextureShader::setColorimetry(Matrix matrix, Range range) const
+{
+  _shader.use();
+  _shader.setUniform("uYuvToRgb", conversion(matrix, range));
+  _shader.setUniform("uYuvOffset", offsets(range));
+}
+
+void YuvTextureShader::use() const
+{
+  _shader.use();
+}
+
+void YuvTextureShader::setMatrixUniform(float scale) const
+{
+  _shader.setMatrixUniform(scale);
+}
+
+void YuvTextureShader::bind(const PlanarTexture& frame) const
+{
+  if (frame.format() != _format)
+  {
+    utils::logger::fatal("graphics::YuvTextureShader - frame is not in the format "
+                         "the shader samples");
+  }
+
+  _shader.use();
+  frame.bind(0);
+}
+} // namespace gfx::graphics
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "pixel_format.hpp"
+#include "shader.hpp"
+#include "yuv_converter.hpp"
+
+namespace gfx::graphics
+{
+class PlanarTexture;
+
+// Displays decoded 4:2:0 video without touching the pixels on the CPU. The
+// planes of a PlanarTexture are sampled as they are and converted to R'G'B'
+// in the fragment shader, 1.5 bytes uploaded per pixel instead of 4 for RGBA.
+// Uses the vertex stage of texture.vertex, so it draws a Quad like Texture.
+//
+//   YuvTextureShader shader{PixelFormat::NV12, YuvTextureShader::Matrix::BT601};
+//   shader.bind(frame);  // the planes on units 0, 1 and 2
+//   quad.draw();
+class YuvTextureShader
+{
+  public:
+    // The colorimetry YuvConverter encodes with
+    using Matrix = YuvConverter::Matrix;
+    using Range  = YuvConverter::Range;
+
+    // 'format' is NV12 or I420
+    explicit YuvTextureShader(PixelFormat format,
+                              Matrix matrix = Matrix::BT709,
+                              Range range   = Range::Limited);
+
+    // Of the stream, usually signalled by the decoder, leaves the program in use
+    void setColorimetry(Matrix matrix, Range range) const;
+
+    void use() const;
+    void setMatrixUniform(float scale) const;
+
+    // use and bind the planes of 'frame' from unit 0, the caller draws. Fatal
+    // when 'frame' is not in the format of the shader.
+    void bind(const PlanarTexture& frame) const;
+
+  private:
+    Shader _shader;
+    PixelFormat _format;
+};
+} // namespace gfx::graphics
@@ -1,11 +1,17 @@
 #include "gamepad.hpp"
 
+#include "utils/logger.hpp"
+
 #include <GLFW/glfw3.h>
 
+// Held buttons log every frame, each button collapses repeats into one count
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
 #define LOGBUTTON(ID, ARRAY)                                                           \
   if ((ARRAY)[(ID)] == GLFW_PRESS)                                                     \
-  std::cout << #ID << '\n'
+  {                                                                                    \
+    static gfx::utils::logger::Deduplicate site{};                                     \
+    gfx::utils::logger::info(site, "{}", #ID);                                         \
+  }
 
 namespace gfx::input::glfw_util
 {
@@ -61,12 +67,16 @@ void Gamepad::_invalidate()
 void Gamepad::_updateDirectionalPad(const DirectionalPadData& newButtons)
 {
   constexpr auto ButtonEnumOffset = button::UP;
+
+  // A worn or noisy d-pad toggles every poll
+  static utils::logger::RateLimit site{10}; // NOLINT
+
   const bool glfwUp = newButtons[button::UP - ButtonEnumOffset] == GLFW_PRESS;
   if (glfwUp != _directionalPad.up)
   {
     _directionalPad.updated = true;
     _directionalPad.up      = glfwUp;
-    std::cout << "DPAD UP: " << _directionalPad.up << '\n';
+    utils::logger::info(site, "DPAD UP: {}", _directionalPad.up);
   }
 
   const bool glfwDown = newButtons[button::DOWN - ButtonEnumOffset] == GLFW_PRESS;
@@ -74,7 +84,7 @@ void Gamepad::_updateDirectionalPad(const DirectionalPadData& newButtons)
   {
     _directionalPad.updated = true;
     _directionalPad.down    = glfwDown;
-    std::cout << "DPAD DOWN: " << _directionalPad.down << '\n';
+    utils::logger::info(site, "DPAD DOWN: {}", _directionalPad.down);
   }
 
   const bool glfwLeft = newButtons[button::LEFT - ButtonEnumOffset] == GLFW_PRESS;
@@ -82,7 +92,7 @@ void Gamepad::_updateDirectionalPad(const DirectionalPadData& newButtons)
   {
     _directionalPad.updated = true;
     _directionalPad.left    = glfwLeft;
-    std::cout << "DPAD LEFT: " << _directionalPad.left << '\n';
+    utils::logger::info(site, "DPAD LEFT: {}", _directionalPad.left);
   }
 
   const bool glfwRight = newButtons[button::RIGHT - ButtonEnumOffset] == GLFW_PRESS;
@@ -90,7 +100,7 @@ void Gamepad::_updateDirectionalPad(const DirectionalPadData& newButtons)
   {
     _directionalPad.updated = true;
     _directionalPad.right   = glfwRight;
-    std::cout << "DPAD RIGHT: " << _directionalPad.right << '\n';
+    utils::logger::info(site, "DPAD RIGHT: {}", _directionalPad.right);
   }
 }
 
@@ -2,7 +2,9 @@ add_library(gamepad STATIC)
 
 target_sources(gamepad PRIVATE ${CMAKE_CURRENT_LIST_DIR}/gamepad.cpp)
 
-target_link_libraries(gamepad glfw)
+target_include_directories(gamepad PRIVATE ${CMAKE_CURRENT_LIST_DIR}/../)
+
+target_link_libraries(gamepad glfw utils::logger)
 
 add_library(input::gamepad ALIAS gamepad)
 
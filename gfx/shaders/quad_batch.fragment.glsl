@@ -0,0 +1,20 @@
+#version 330 core
+
+in vec3 texCoord;
+in vec4 color;
+
+out vec4 fragColor;
+
+uniform sampler2DArray texSampler;
+
+void main()
+{
+  // Negative layer, untextured
+  if (texCoord.z < 0.0)
+  {
+    fragColor = color;
+    return;
+  }
+
+  fragColor = texture(texSampler, texCoord) * color;
+}
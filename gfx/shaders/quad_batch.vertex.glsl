@@ -0,0 +1,23 @@
+#version 330 core
+
+// Per instance, the quad itself comes from gl_VertexID
+layout(location = 0) in vec4 aRect;
+layout(location = 1) in vec2 aRotationLayer;
+layout(location = 2) in vec4 aColor;
+layout(location = 3) in vec4 aUv;
+
+out vec3 texCoord;
+out vec4 color;
+
+void main()
+{
+  // Triangle strip corners (-1, -1) (1, -1) (-1, 1) (1, 1)
+  vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0 - 1.0;
+
+  float s = sin(aRotationLayer.x);
+  float c = cos(aRotationLayer.x);
+
+  gl_Position = vec4(aRect.xy + mat2(c, s, -s, c) * (corner * aRect.zw), 0.0, 1.0);
+  texCoord    = vec3(mix(aUv.xy, aUv.zw, corner * 0.5 + 0.5), aRotationLayer.y);
+  color       = aColor;
+}
@@ -0,0 +1,102 @@
+#version 430
+// One invocation converts 8x2 pixels and writes whole words only, 2+2 luma and
+// 1+1 chroma, so no two invocations touch the same word for widths that are a
+// multiple of 8
+layout(local_size_x = 16, local_size_y = 16) in;
+
+layout(rgba8, binding = 0) readonly uniform image2D rgbImage;
+
+// Planes back to back without padding, as a raw frame for the muxer
+layout(std430, binding = 0) writeonly buffer Planes
+{
+  uint words[];
+};
+
+// R'G'B' in [0, 1] to Y'CbCr code values in [0, 255]
+uniform mat3 uMatrix;
+uniform vec3 uOffset;
+
+uniform int uWidth;
+uniform int uHeight;
+
+// NV12 interleaves CbCr in one plane, I420 has a Cb and a Cr plane
+uniform bool uInterleaved;
+
+// Read rows bottom up, for textures rendered by OpenGL
+uniform bool uFlip;
+
+const ivec2 block = ivec2(8, 2);
+
+vec3 convert(vec3 rgb)
+{
+  return clamp(round(uMatrix * rgb + uOffset), 0.0, 255.0);
+}
+
+uint pack(vec4 bytes)
+{
+  uvec4 value = uvec4(bytes);
+  return value.x | (value.y << 8) | (value.z << 16) | (value.w << 24);
+}
+
+void main(void)
+{
+  ivec2 uSize = ivec2(uWidth, uHeight);
+  ivec2 origin = ivec2(gl_GlobalInvocationID.xy) * block;
+  if (origin.x >= uSize.x || origin.y >= uSize.y)
+  {
+    return;
+  }
+
+  float luma[16];
+  vec3 rgb[4] = vec3[4](vec3(0.0), vec3(0.0), vec3(0.0), vec3(0.0));
+
+  for (int row = 0; row < block.y; ++row)
+  {
+    int y = origin.y + row;
+    y     = uFlip ? uSize.y - 1 - y : y;
+    for (int column = 0; column < block.x; ++column)
+    {
+      vec3 pixel = imageLoad(rgbImage, ivec2(origin.x + column, y)).rgb;
+      luma[row * block.x + column] = convert(pixel).x;
+      rgb[column / 2] += pixel * 0.25;
+    }
+  }
+
+  for (int row = 0; row < block.y; ++row)
+  {
+    int word = ((origin.y + row) * uSize.x + origin.x) / 4;
+    for (int part = 0; part < 2; ++part)
+    {
+      int first          = row * block.x + part * 4;
+      words[word + part] = pack(vec4(luma[first],
+                                     luma[first + 1],
+                                     luma[first + 2],
+                                     luma[first + 3]));
+    }
+  }
+
+  vec3 chroma[4];
+  for (int index = 0; index < 4; ++index)
+  {
+    chroma[index] = convert(rgb[index]);
+  }
+
+  int lumaSize   = uSize.x * uSize.y;
+  int chromaRow  = origin.y / 2;
+  int chromaByte = origin.x / 2;
+
+  if (uInterleaved)
+  {
+    int word        = (lumaSize + chromaRow * uSize.x + chromaByte * 2) / 4;
+    words[word]     = pack(vec4(chroma[0].yz, chroma[1].yz));
+    words[word + 1] = pack(vec4(chroma[2].yz, chroma[3].yz));
+  }
+  else
+  {
+    int planeSize = lumaSize / 4;
+    int word      = (lumaSize + chromaRow * uSize.x / 2 + chromaByte) / 4;
+    words[word]   = pack(vec4(chroma[0].y, chroma[1].y, chroma[2].y, chroma[3].y));
+    words[word + planeSize / 4] = pack(
+        vec4(chroma[0].z, chroma[1].z, chroma[2].z, chroma[3].z));
+  }
+}
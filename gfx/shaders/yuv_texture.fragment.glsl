@@ -0,0 +1,33 @@
+#version 330 core
+
+in vec2 texCoord;
+
+out vec4 fragColor;
+
+// Y, then Cb and Cr as R8 planes, or CbCr as one RG8 plane
+uniform sampler2D uLuma;
+uniform sampler2D uChromaBlue;
+uniform sampler2D uChromaRed;
+uniform int uInterleaved;
+
+// Normalized code values to R'G'B', see YuvTextureShader
+uniform mat3 uYuvToRgb;
+uniform vec3 uYuvOffset;
+
+void main()
+{
+  vec3 yuv;
+  yuv.x = texture(uLuma, texCoord).r;
+
+  if (uInterleaved != 0)
+  {
+    yuv.yz = texture(uChromaBlue, texCoord).rg;
+  }
+  else
+  {
+    yuv.y = texture(uChromaBlue, texCoord).r;
+    yuv.z = texture(uChromaRed, texCoord).r;
+  }
+
+  fragColor = vec4(clamp(uYuvToRgb * (yuv - uYuvOffset), 0.0, 1.0), 1.0);
+}
@@ -13,7 +13,7 @@ namespace gfx::shmem::detail
   std::array<char, length> errorString{};
   const auto* result = strerror_r(errno, errorString.data(), errorString.size());
 
-  utils::logger::fatal(function, result);
+  utils::logger::fatal("{}: {}", function, result);
 }
 
 static void checkForError(int returnValue, const char* function, int errorCode = -1)
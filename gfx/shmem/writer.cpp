@@ -46,7 +46,7 @@ Writer::~Writer()
   sem_unlink((_name + "_full").c_str());
 }
 
-void Writer::write(void* data)
+void Writer::write(const void* data)
 {
   sem_wait(_semaphoreMutex);
   memcpy(_address, data, _size);
@@ -19,7 +19,7 @@ class Writer
     Writer(Writer&&)                 = delete;
     Writer& operator=(Writer&&)      = delete;
 
-    void write(void* data);
+    void write(const void* data);
 
   private:
     std::string _name{};
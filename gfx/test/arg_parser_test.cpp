@@ -7,6 +7,7 @@
 
 #include <chrono>
 #include <concepts>
+#include <filesystem>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -88,4 +89,34 @@ TEST_CASE("argparser_test", "[gfx][utils][arg_parser]")
       REQUIRE(std::string{result.getInputUri().c_str()} == "unix:/tmp/test");
     }
   }
+
+  GIVEN("argc and argv with shmem name")
+  {
+    const gfx::test::CLI cli{"--shmem-name", "/gfx_video"};
+    THEN("get shmem name from arg parser")
+    {
+      auto result = gfx::utils::ArgParser(cli.argc(), cli.argv());
+      REQUIRE(result.getShmemName() == "/gfx_video");
+    }
+  }
+
+  GIVEN("argc and argv with trace")
+  {
+    const gfx::test::CLI cli{"--trace", "/tmp/gfx.trace"};
+    THEN("get trace path from arg parser")
+    {
+      auto result = gfx::utils::ArgParser(cli.argc(), cli.argv());
+      REQUIRE(result.getTracePath() == std::filesystem::path{"/tmp/gfx.trace"});
+    }
+  }
+
+  GIVEN("argc and argv without trace")
+  {
+    const gfx::test::CLI cli{"--verbose"};
+    THEN("tracing is off")
+    {
+      auto result = gfx::utils::ArgParser(cli.argc(), cli.argv());
+      REQUIRE_FALSE(result.getTracePath().has_value());
+    }
+  }
 }
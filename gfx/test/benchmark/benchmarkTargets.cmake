@@ -0,0 +1,65 @@
+add_executable(benchmarks)
+
+target_link_libraries(benchmarks PRIVATE Catch2::Catch2WithMain)
+
+# Same layout as unit tests, run with e.g. 'benchmarks [logger]'
+function(obj_benchmark unit)
+  set(varargs DEPENDENCIES INCLUDE_PATH)
+  cmake_parse_arguments(
+    OBJ_BENCHMARK
+    ""
+    ""
+    "${varargs}"
+    ${ARGN}
+  )
+
+  add_library(
+    obj_${unit}_benchmark OBJECT ${CMAKE_CURRENT_LIST_DIR}/${unit}_benchmark.cpp
+  )
+
+  target_include_directories(
+    obj_${unit}_benchmark PRIVATE ${CMAKE_SOURCE_DIR}/${OBJ_BENCHMARK_INCLUDE_PATH}
+  )
+
+  target_link_libraries(
+    obj_${unit}_benchmark PRIVATE ${OBJ_BENCHMARK_DEPENDENCIES}
+  )
+
+  set_target_properties(
+    obj_${unit}_benchmark
+    PROPERTIES CXX_CLANG_TIDY "${GFX_CLANG_TIDY_CATCH2_TARGET_PROPERTIES}"
+               CXX_INCLUDE_WHAT_YOU_USE "${GFX_IWYU_CATCH2_TARGET_PROPERTIES}"
+  )
+
+  target_link_libraries(benchmarks PRIVATE obj_${unit}_benchmark)
+endfunction()
+
+obj_benchmark(
+  logger
+  DEPENDENCIES utils::logger
+  INCLUDE_PATH gfx/utils/
+)
+
+obj_benchmark(
+  streaming_texture
+  DEPENDENCIES graphics::window graphics::components utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_benchmark(
+  image_sink
+  DEPENDENCIES utils::image_sink utils::thread_pool stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_benchmark(
+  quad_batch
+  DEPENDENCIES graphics::window graphics::components utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_benchmark(
+  yuv_converter
+  DEPENDENCIES graphics::window graphics::components utils::logger
+  INCLUDE_PATH gfx/
+)
@@ -0,0 +1,102 @@
+#include "utils/image_sink.hpp"
+#include "utils/thread_pool.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Input bytes per second over a few encodes, to print after Catch's timings
+template <typename Encode>
+std::string throughput(std::string_view name, size_t bytes, const Encode& encode)
+{
+  constexpr size_t runs{8};
+
+  size_t encoded{0};
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t run = 0; run < runs; ++run)
+  {
+    encoded += encode().size();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now()
+                                              - start;
+
+  return fmt::format("{:<24} {:>14.0f} bytes/s, {} bytes encoded",
+                     name,
+                     static_cast<double>(bytes * runs) / elapsed.count(),
+                     encoded / runs);
+}
+} // namespace
+
+// One flipped 1080p RGBA frame per iteration, as the dumps write them. Picks
+// the format for bulk capture.
+TEST_CASE("Image encode", "[gfx][utils][image_sink]")
+{
+  namespace image = gfx::utils::image;
+
+  constexpr gfx::Size size{1920, 1080};
+  constexpr size_t width{1920};
+
+  // Gradients with some noise, neither trivially compressible nor random
+  std::vector<uint8_t> pixels(size.size() * 4);
+  uint32_t state{1};
+  for (size_t index = 0; index < size.size(); ++index)
+  {
+    const size_t x = index % width;
+    const size_t y = index / width;
+    state          = state * 1664525U + 1013904223U; // NOLINT
+
+    pixels[index * 4]     = static_cast<uint8_t>(x / 8);                // NOLINT
+    pixels[index * 4 + 1] = static_cast<uint8_t>(y / 4);                // NOLINT
+    pixels[index * 4 + 2] = static_cast<uint8_t>((x + y) / 16);         // NOLINT
+    pixels[index * 4 + 3] = static_cast<uint8_t>(255 - (state >> 30U)); // NOLINT
+  }
+
+  const image::Image frame{pixels, size, 4, true};
+  gfx::utils::ThreadPool pool{4};
+
+  const std::vector<std::pair<std::string, image::Format>> formats{
+      {"raw", image::Format::Raw},
+      {"ppm", image::Format::PPM},
+      {"qoi", image::Format::QOI},
+      {"jpg", image::Format::JPEG},
+      {"png", image::Format::PNG},
+  };
+
+  std::vector<std::string> throughputs{};
+  for (const auto& [name, format] : formats)
+  {
+    BENCHMARK(std::string{name})
+    {
+      return image::encode(format, frame);
+    };
+
+    BENCHMARK(name + " rows on 4 threads")
+    {
+      return image::encode(format, frame, {.pool = &pool});
+    };
+
+    throughputs.push_back(throughput(name, pixels.size(), [&] {
+      return image::encode(format, frame);
+    }));
+    throughputs.push_back(throughput(name + " rows on 4 threads", pixels.size(), [&] {
+      return image::encode(format, frame, {.pool = &pool});
+    }));
+  }
+
+  for (const std::string& line : throughputs)
+  {
+    fmt::print("{}\n", line);
+  }
+}
@@ -0,0 +1,53 @@
+#include "logger.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace
+{
+// Per call cost of the logger before preambles were cached, kept as reference
+void previous_error(std::string_view msg)
+{
+  std::string name{};
+  std::ifstream("/proc/self/comm") >> name;
+
+  std::stringstream tag;
+  tag << "\x1B[31m" << "ERROR" << "\x1B[39m";
+
+  std::stringstream preamble;
+  preamble << "\x1B[1m" << "gfx::" << name << " [" << tag.str() << "] " << "\x1B[0m";
+
+  std::cerr << preamble.str() << msg << '\n';
+}
+} // namespace
+
+// Writes to stderr, run as 'benchmarks [logger] 2>/dev/null'
+TEST_CASE("Logger per call cost", "[gfx][utils][logger]")
+{
+  constexpr std::string_view msg{"frame 1234 took longer than expected"};
+
+  BENCHMARK("previous preamble and streams")
+  {
+    previous_error(msg);
+  };
+
+  BENCHMARK("logger::error")
+  {
+    gfx::utils::logger::error("{}", msg);
+  };
+
+  gfx::utils::logger::enable_async();
+
+  BENCHMARK("logger::error async")
+  {
+    gfx::utils::logger::error("{}", msg);
+  };
+
+  gfx::utils::logger::disable_async();
+}
@@ -0,0 +1,57 @@
+#include "graphics/quad.hpp"
+#include "graphics/quad_batch.hpp"
+#include "graphics/shader.hpp"
+#include "graphics/window.hpp"
+#include "shaders/texture.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <string>
+
+// Small tiles so submission dominates over fill. One frame per iteration, the
+// quads per frame at 60 Hz are N * 16.7 / mean in ms.
+TEST_CASE("Quads per frame", "[gfx][graphics][quad_batch]")
+{
+  const gfx::graphics::Window window{"quad_batch_benchmark",
+                                     gfx::Size{640, 360},
+                                     gfx::graphics::Window::Mode::Headless};
+
+  const gfx::graphics::Shader shader{gfx::graphics::shaders::Texture::vertex,
+                                     gfx::graphics::shaders::Texture::fragment};
+  const gfx::graphics::Quad quad{};
+
+  for (const size_t count : {size_t{1'000}, size_t{10'000}, size_t{100'000}})
+  {
+    gfx::graphics::QuadBatch batch{count};
+
+    BENCHMARK("QuadBatch " + std::to_string(count))
+    {
+      for (size_t index = 0; index < count; ++index)
+      {
+        const auto position = static_cast<float>(index % 200) / 100.0F - 1.0F;
+        batch.add({.x          = position,
+                   .y          = -position,
+                   .halfWidth  = 0.01F,
+                   .halfHeight = 0.01F});
+      }
+      batch.draw();
+      glFinish();
+    };
+
+    BENCHMARK("Quad::draw " + std::to_string(count))
+    {
+      shader.use();
+      for (size_t index = 0; index < count; ++index)
+      {
+        shader.setMatrixUniform(0.01F);
+        quad.draw();
+      }
+      glFinish();
+    };
+  }
+}
@@ -0,0 +1,53 @@
+#include "graphics/streaming_texture.hpp"
+#include "graphics/texture.hpp"
+#include "graphics/window.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One 1080p RGBA frame per iteration, 8294400 bytes, MB/s is 8294 / mean in ms
+TEST_CASE("Texture upload", "[gfx][graphics][streaming_texture]")
+{
+  const gfx::graphics::Window window{"streaming_texture_benchmark",
+                                     gfx::Size{64, 64},
+                                     gfx::graphics::Window::Mode::Headless};
+
+  constexpr gfx::Size size{1920, 1080};
+  const std::vector<uint8_t> frame(size.width * size.height * 4, 0x80); // NOLINT
+
+  const gfx::graphics::Texture texture{size};
+
+  BENCHMARK("glTexSubImage2D from client memory")
+  {
+    texture.bind();
+    glTexSubImage2D(GL_TEXTURE_2D,
+                    0,
+                    0,
+                    0,
+                    static_cast<GLsizei>(size.width),
+                    static_cast<GLsizei>(size.height),
+                    GL_RGBA,
+                    GL_UNSIGNED_BYTE,
+                    frame.data());
+  };
+
+  for (const size_t depth : {size_t{1}, size_t{2}, size_t{3}})
+  {
+    gfx::graphics::StreamingTexture streaming{size, depth};
+
+    BENCHMARK("StreamingTexture depth " + std::to_string(depth))
+    {
+      streaming.upload(frame);
+    };
+  }
+
+  glFinish();
+}
@@ -0,0 +1,68 @@
+#include "graphics/shader.hpp"
+#include "graphics/texture.hpp"
+#include "graphics/window.hpp"
+#include "graphics/yuv_converter.hpp"
+#include "shaders/yuv.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <vector>
+
+// One 1080p frame per iteration including the wait for the GPU, frames per
+// second is 1000 / mean in ms. yuv.compute is the one work group per pixel
+// shader of opengl-compute-shader writing packed YUV into an RGBA8 image.
+TEST_CASE("RGB to YUV conversion", "[gfx][graphics][yuv_converter]")
+{
+  using gfx::graphics::YuvConverter;
+
+  const gfx::graphics::Window window{"yuv_converter_benchmark",
+                                     gfx::Size{64, 64},
+                                     gfx::graphics::Window::Mode::Headless};
+
+  constexpr gfx::Size size{1920, 1080};
+  std::vector<uint8_t> pixels(size.width * size.height * 4, 0x80); // NOLINT
+
+  const gfx::graphics::Texture input{size, pixels.data()};
+  const gfx::graphics::Texture output{size};
+
+  const gfx::graphics::Shader yuv{gfx::graphics::shaders::Yuv::compute};
+
+  BENCHMARK("yuv.compute 1x1 work groups, RGBA8")
+  {
+    yuv.use();
+    glBindImageTexture(0, input.get(), 0, GL_FALSE, 0, GL_READ_ONLY, GL_RGBA8);
+    glBindImageTexture(1, output.get(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+    glDispatchCompute(size.width, size.height, 1);
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+    glFinish();
+  };
+
+  const YuvConverter i420{size, YuvConverter::Layout::I420};
+
+  BENCHMARK("YuvConverter 16x16 work groups, I420")
+  {
+    i420.convert(input.get());
+    glFinish();
+  };
+
+  const YuvConverter nv12{size, YuvConverter::Layout::NV12};
+
+  BENCHMARK("YuvConverter 16x16 work groups, NV12")
+  {
+    nv12.convert(input.get());
+    glFinish();
+  };
+
+  std::vector<uint8_t> frame(i420.frameSize());
+
+  BENCHMARK("YuvConverter I420 and read back")
+  {
+    i420.convert(input.get());
+    i420.read(frame);
+  };
+}
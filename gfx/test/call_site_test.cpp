@@ -0,0 +1,72 @@
+#include "logger.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+
+SCENARIO("Rate limited log call site", "[gfx][utils][logger]")
+{
+  GIVEN("a site allowing three lines a second")
+  {
+    gfx::utils::logger::RateLimit site{3};
+    constexpr uint32_t second{100};
+
+    WHEN("ten lines are logged within one second")
+    {
+      int allowed{0};
+      uint64_t suppressed{0};
+      for (int line = 0; line < 10; ++line) // NOLINT
+      {
+        uint64_t reported{0};
+        if (site.acquire(reported, second))
+        {
+          ++allowed;
+          suppressed += reported;
+        }
+      }
+
+      THEN("only the budget is written")
+      {
+        REQUIRE(allowed == 3);
+        REQUIRE(suppressed == 0);
+
+        uint64_t reported{0};
+        REQUIRE_FALSE(site.acquire(reported, second));
+      }
+
+      THEN("the first line of the next second reports every suppressed one")
+      {
+        uint64_t reported{0};
+        REQUIRE(site.acquire(reported, second + 1));
+        REQUIRE(reported == 7);
+      }
+    }
+  }
+}
+
+SCENARIO("Deduplicated log call site", "[gfx][utils][logger]")
+{
+  GIVEN("a site that saw a line")
+  {
+    gfx::utils::logger::Deduplicate site{};
+    REQUIRE(site.check(1).write);
+
+    WHEN("the same line repeats")
+    {
+      uint64_t repeats{0};
+      for (int line = 0; line < 500; ++line) // NOLINT
+      {
+        const auto decision = site.check(1);
+        REQUIRE_FALSE(decision.write);
+        repeats += decision.repeats;
+      }
+
+      THEN("a different line is written after the remaining count")
+      {
+        const auto decision = site.check(2);
+        REQUIRE(decision.write);
+        REQUIRE(repeats + decision.repeats == 500);
+      }
+    }
+  }
+}
@@ -0,0 +1,159 @@
+#include "utils/converter.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+extern "C"
+{
+#include <libavutil/frame.h>
+#include <libavutil/pixfmt.h>
+}
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+struct FrameDeleter
+{
+    void operator()(AVFrame* frame) const
+    {
+      av_frame_free(&frame);
+    }
+};
+
+using Frame = std::unique_ptr<AVFrame, FrameDeleter>;
+
+constexpr gfx::Size size{4, 2};
+constexpr size_t width{4};
+constexpr size_t height{2};
+
+// RGBA of 'size', 'pixel' gives the four channels of each one
+template <typename Pixel>
+Frame rgba_frame(const Pixel& pixel)
+{
+  Frame frame{av_frame_alloc()};
+  frame->width  = size.width;
+  frame->height = size.height;
+  frame->format = AV_PIX_FMT_RGBA;
+  REQUIRE(av_frame_get_buffer(frame.get(), 0) == 0);
+
+  for (size_t y = 0; y < height; ++y)
+  {
+    uint8_t* row = frame->data[0] + y * static_cast<size_t>(frame->linesize[0]);
+    for (size_t x = 0; x < width * 4; ++x)
+    {
+      row[x] = pixel(x / 4, y, x % 4);
+    }
+  }
+  return frame;
+}
+
+bool close_to(uint8_t value, uint8_t expected)
+{
+  return value + 2 >= expected && value <= expected + 2;
+}
+} // namespace
+
+SCENARIO("Converting decoded frames into caller memory", "[gfx][utils][converter]")
+{
+  using gfx::utils::video::Converter;
+  using gfx::utils::video::OutputFormat;
+
+  Converter converter{1};
+
+  GIVEN("an RGBA frame where every pixel differs")
+  {
+    const auto pixel = [](size_t x, size_t y, size_t channel) {
+      return static_cast<uint8_t>(channel == 3 ? 0xFF : (y * 4 + x) * 16 + channel);
+    };
+    const Frame source = rgba_frame(pixel);
+
+    WHEN("it is converted to RGBA of the same size")
+    {
+      const int format = Converter::toPixelFormat(OutputFormat::RGBA, source->format);
+      std::vector<uint8_t> output(Converter::bufferSize(size, format));
+      converter.convert(source.get(), output, size, format);
+
+      THEN("the rows come out packed and unchanged")
+      {
+        REQUIRE(output.size() == width * height * 4);
+        for (size_t index = 0; index < output.size(); ++index)
+        {
+          REQUIRE(output[index] == pixel(index / 4 % 4, index / 16, index % 4));
+        }
+      }
+    }
+
+    WHEN("the destination is too small")
+    {
+      constexpr uint8_t untouched{0xAB};
+      std::vector<uint8_t> output(width * height * 4 - 1, untouched);
+
+      THEN("it throws and nothing is written")
+      {
+        REQUIRE_THROWS_AS(
+            converter.convert(source.get(), output, size, AV_PIX_FMT_RGBA),
+            std::invalid_argument);
+        REQUIRE(std::ranges::all_of(output,
+                                    [](uint8_t value) { return value == untouched; }));
+      }
+    }
+  }
+
+  GIVEN("a mid grey RGBA frame")
+  {
+    const Frame source = rgba_frame([](size_t, size_t, size_t channel) {
+      return static_cast<uint8_t>(channel == 3 ? 0xFF : 0x80);
+    });
+
+    WHEN("it is converted to NV12")
+    {
+      const int format = Converter::toPixelFormat(OutputFormat::NV12, source->format);
+      std::vector<uint8_t> output(Converter::bufferSize(size, format));
+      converter.convert(source.get(), output, size, format);
+
+      THEN("the luma plane is followed by interleaved neutral chroma")
+      {
+        // BT.601 limited range, 16 + 219 * 128 / 255
+        REQUIRE(output.size() == 12);
+        for (size_t index = 0; index < 8; ++index)
+        {
+          REQUIRE(close_to(output[index], 126));
+        }
+        for (size_t index = 8; index < 12; ++index)
+        {
+          REQUIRE(close_to(output[index], 128));
+        }
+      }
+    }
+
+    WHEN("it is scaled down to a quarter")
+    {
+      constexpr gfx::Size half{2, 1};
+      std::vector<uint8_t> output(Converter::bufferSize(half, AV_PIX_FMT_RGBA));
+      converter.convert(source.get(), output, half, AV_PIX_FMT_RGBA);
+
+      THEN("the pixels keep their colour")
+      {
+        REQUIRE(output.size() == 8);
+        REQUIRE(close_to(output[0], 0x80));
+        REQUIRE(close_to(output[5], 0x80));
+        REQUIRE(output[7] == 0xFF);
+      }
+    }
+  }
+
+  GIVEN("the native output format")
+  {
+    THEN("it is the format of the decoder")
+    {
+      REQUIRE(Converter::toPixelFormat(OutputFormat::Native, AV_PIX_FMT_YUV420P)
+              == AV_PIX_FMT_YUV420P);
+    }
+  }
+}
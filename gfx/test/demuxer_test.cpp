@@ -0,0 +1,176 @@
+#include "utils/demuxer.hpp"
+#include "utils/frame.hpp"
+#include "utils/muxer.hpp"
+#include "vocabulary/size.hpp"
+#include "vocabulary/time.hpp"
+#include "vocabulary/uri.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+// The muxer puts a keyframe every 12 frames, every 500 ms at this rate
+constexpr gfx::time::fps frameRate{24};
+
+std::filesystem::path directory()
+{
+  const auto path = std::filesystem::temp_directory_path() / "gfx_demuxer_test";
+  std::filesystem::create_directories(path);
+  return path;
+}
+
+gfx::URI file_uri(const std::filesystem::path& path)
+{
+  return gfx::URI{"file:" + path.string()};
+}
+
+// The test pattern runs to the frame at 'duration' inclusive
+void write_clip(const std::filesystem::path& path,
+                const gfx::Size& size,
+                gfx::time::ms duration)
+{
+  gfx::utils::video::Muxer muxer{file_uri(path), size, frameRate};
+  REQUIRE(muxer.writeTestPattern(duration));
+}
+
+// MPEG-TS segments play back to back when concatenated, like a live source that
+// switches resolution
+void concatenate(const std::filesystem::path& path,
+                 const std::vector<std::filesystem::path>& segments)
+{
+  std::ofstream output{path, std::ios::binary};
+  for (const auto& segment : segments)
+  {
+    output << std::ifstream{segment, std::ios::binary}.rdbuf();
+  }
+}
+
+size_t rgba_size(const gfx::Size& size)
+{
+  return size.size() * 4;
+}
+} // namespace
+
+SCENARIO("Decoding one keyframe per interval", "[gfx][utils][demuxer]")
+{
+  using gfx::utils::video::Demuxer;
+  using gfx::utils::video::Frame;
+  using gfx::time::ms;
+
+  GIVEN("a two second clip with a keyframe every 500 ms")
+  {
+    const auto clip = directory() / "sparse.mp4";
+    write_clip(clip, gfx::Size{64, 48}, std::chrono::seconds{2});
+
+    Demuxer demuxer{file_uri(clip)};
+
+    WHEN("it is decoded sparsely once per second")
+    {
+      std::vector<ms> timestamps{};
+      const bool success = demuxer.decodeSparse(
+          std::chrono::seconds{1},
+          [&](const Frame& frame) {
+            timestamps.push_back(frame.timestamp);
+            return true;
+          });
+
+      THEN("only the keyframe at every second comes out")
+      {
+        REQUIRE(success);
+        REQUIRE(timestamps == std::vector<ms>{ms{0}, ms{1000}, ms{2000}});
+      }
+    }
+
+    WHEN("the callback stops after the first keyframe")
+    {
+      int64_t frames{0};
+      const bool success = demuxer.decodeSparse(std::chrono::seconds{1},
+                                                [&](const Frame&) {
+                                                  ++frames;
+                                                  return false;
+                                                });
+
+      THEN("decoding ends without an error")
+      {
+        REQUIRE(success);
+        REQUIRE(frames == 1);
+      }
+    }
+
+    WHEN("it is decoded in full")
+    {
+      int64_t frames{0};
+      REQUIRE(demuxer.decode([&](const Frame&) {
+        ++frames;
+        return true;
+      }));
+
+      THEN("every frame comes out")
+      {
+        REQUIRE(frames == 2 * frameRate + 1);
+      }
+    }
+  }
+}
+
+SCENARIO("Following a mid-stream format change", "[gfx][utils][demuxer]")
+{
+  using gfx::utils::video::Demuxer;
+  using gfx::utils::video::Frame;
+  using gfx::utils::video::OutputFormat;
+
+  GIVEN("a stream switching from 64x48 to 96x64 after one second")
+  {
+    constexpr gfx::Size first{64, 48};
+    constexpr gfx::Size second{96, 64};
+
+    const auto clip = directory() / "format_change.ts";
+    write_clip(directory() / "first.ts", first, std::chrono::seconds{1});
+    write_clip(directory() / "second.ts", second, std::chrono::seconds{1});
+    concatenate(clip, {directory() / "first.ts", directory() / "second.ts"});
+
+    Demuxer demuxer{file_uri(clip)};
+    demuxer.setOutput(OutputFormat::RGBA);
+
+    std::vector<Frame> frames{};
+    std::vector<gfx::Size> changes{};
+    size_t changedAt{0};
+    demuxer.onFormatChange([&](const gfx::Size& size, int) {
+      changes.push_back(size);
+      changedAt = frames.size();
+    });
+
+    WHEN("it is decoded without a fixed output size")
+    {
+      REQUIRE(demuxer.decode([&](const Frame& frame) {
+        // Only the metadata, the data is reused for the next frame
+        frames.push_back(frame);
+        return true;
+      }));
+
+      THEN("the change is reported once, before the first frame of the new size")
+      {
+        REQUIRE(changes == std::vector<gfx::Size>{second});
+        REQUIRE(changedAt == frameRate + 1);
+        REQUIRE(frames.size() == 2 * (frameRate + 1));
+      }
+
+      THEN("frames after it are converted at the new size")
+      {
+        for (size_t index = 0; index < frames.size(); ++index)
+        {
+          const gfx::Size expected = index < changedAt ? first : second;
+          REQUIRE(frames[index].size == expected);
+          REQUIRE(frames[index].data.size() == rgba_size(expected));
+        }
+      }
+    }
+  }
+}
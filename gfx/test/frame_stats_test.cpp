@@ -0,0 +1,81 @@
+#include "frame_stats.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+SCENARIO("Rolling frame statistics", "[gfx][graphics][frame_stats]")
+{
+  GIVEN("no frames")
+  {
+    const gfx::graphics::FrameStats stats{};
+
+    THEN("the summary is empty")
+    {
+      REQUIRE(stats.summary().frames == 0);
+      REQUIRE(stats.summary().fps == Catch::Approx(0.0));
+    }
+  }
+
+  GIVEN("a 60 Hz display and a stutter")
+  {
+    gfx::graphics::FrameStats stats{100, 16'666'667ns};
+
+    for (int frame = 0; frame < 99; ++frame)
+    {
+      stats.add({.cpu = 4ms, .swap = 12ms, .interval = 16ms});
+    }
+    stats.add({.cpu = 30ms, .swap = 3ms, .interval = 33ms});
+
+    THEN("the distributions reflect the frames")
+    {
+      const auto summary = stats.summary();
+      REQUIRE(summary.frames == 100);
+      REQUIRE(summary.interval.p50 == Catch::Approx(16.0));
+      REQUIRE(summary.interval.max == Catch::Approx(33.0));
+      REQUIRE(summary.cpu.p99 == Catch::Approx(4.0));
+      REQUIRE(summary.cpu.max == Catch::Approx(30.0));
+      REQUIRE(summary.swap.p50 == Catch::Approx(12.0));
+    }
+
+    THEN("the long interval is a missed frame")
+    {
+      REQUIRE(stats.summary().missed == 1);
+    }
+
+    WHEN("more frames than the capacity arrive")
+    {
+      for (int frame = 0; frame < 100; ++frame)
+      {
+        stats.add({.cpu = 1ms, .swap = 15ms, .interval = 16ms});
+      }
+
+      THEN("only the recent ones are kept")
+      {
+        const auto summary = stats.summary();
+        REQUIRE(summary.frames == 100);
+        REQUIRE(summary.missed == 0);
+        REQUIRE(summary.cpu.max == Catch::Approx(1.0));
+      }
+    }
+  }
+
+  GIVEN("an unknown refresh rate")
+  {
+    gfx::graphics::FrameStats stats{10};
+    for (int frame = 0; frame < 9; ++frame)
+    {
+      stats.add({.cpu = 1ms, .swap = 1ms, .interval = 10ms});
+    }
+    stats.add({.cpu = 1ms, .swap = 1ms, .interval = 20ms});
+
+    THEN("missed frames are judged against the median interval")
+    {
+      REQUIRE(stats.summary().missed == 1);
+      REQUIRE(stats.summary().fps > 90.0);
+    }
+  }
+}
@@ -0,0 +1,96 @@
+#include "graphics/gpu_profile.hpp"
+#include "graphics/render_target.hpp"
+#include "graphics/window.hpp"
+#include "utils/profile.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <GL/glew.h>
+
+namespace gpu_profile = gfx::graphics::gpu_profile;
+
+// Needs an OpenGL context, hidden from the default run, see streaming_texture_test
+SCENARIO("GPU timer queries", "[gfx][graphics][gpu_profile][.gl]")
+{
+  gfx::graphics::Window window{"gpu_profile_test",
+                               gfx::Size{1, 1},
+                               gfx::graphics::Window::Mode::Offscreen};
+
+  const gfx::graphics::RenderTarget target{gfx::Size{512, 512}};
+  target.bind();
+
+  GIVEN("a GPU zone")
+  {
+    auto& zone = gpu_profile::zone("gpu_profile_test outer");
+
+    THEN("it sits next to the CPU zone of the same name")
+    {
+      REQUIRE(zone.name == "gpu_profile_test outer (gpu)");
+      REQUIRE(&zone == &gpu_profile::zone("gpu_profile_test outer"));
+    }
+
+    WHEN("nested scopes bracket GPU work and the results are collected")
+    {
+      auto& inner = gpu_profile::zone("gpu_profile_test inner");
+      {
+        const gpu_profile::Scope outerScope{zone};
+        glClear(GL_COLOR_BUFFER_BIT);
+        {
+          const gpu_profile::Scope innerScope{inner};
+          glClear(GL_COLOR_BUFFER_BIT);
+        }
+        glClear(GL_COLOR_BUFFER_BIT);
+      }
+      gpu_profile::collect(true);
+
+      THEN("each zone has one duration and the outer one covers the inner")
+      {
+        REQUIRE(zone.histogram.summary().count == 1);
+        REQUIRE(inner.histogram.summary().count == 1);
+        REQUIRE(zone.histogram.summary().max >= inner.histogram.summary().max);
+        REQUIRE(gpu_profile::dropped() == 0);
+      }
+
+      zone.histogram.reset();
+      inner.histogram.reset();
+    }
+  }
+
+  GIVEN("a window that swaps")
+  {
+    auto& frame = gpu_profile::zone("frame");
+    frame.histogram.reset();
+
+    window.swap();
+    glClear(GL_COLOR_BUFFER_BIT);
+    window.swap();
+    gpu_profile::collect(true);
+
+    THEN("the GPU time between swaps is recorded as a frame")
+    {
+      REQUIRE(frame.histogram.summary().count == 1);
+    }
+
+    WHEN("a frame holds more scopes than the ring")
+    {
+      auto& draw = gpu_profile::zone("gpu_profile_test draw");
+      for (int batch = 0; batch < 3; ++batch)
+      {
+        for (int index = 0; index < 600; ++index)
+        {
+          const gpu_profile::Scope scope{draw};
+        }
+        gpu_profile::collect(true);
+      }
+
+      THEN("the ones that ended are collected past the open frame")
+      {
+        REQUIRE(draw.histogram.summary().count == 1800);
+        REQUIRE(gpu_profile::dropped() == 0);
+      }
+
+      draw.histogram.reset();
+    }
+  }
+}
@@ -0,0 +1,201 @@
+#include "utils/image_sink.hpp"
+#include "utils/thread_pool.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Reference decoder straight from the QOI specification, RGBA output
+std::vector<uint8_t> decode_qoi(std::span<const uint8_t> bytes, size_t pixels)
+{
+  std::vector<uint8_t> output{};
+  std::array<std::array<uint8_t, 4>, 64> seen{};
+  std::array<uint8_t, 4> pixel{0, 0, 0, 255};
+
+  size_t offset{14};
+  while (output.size() < pixels * 4)
+  {
+    const uint8_t op = bytes[offset++];
+    int run{1};
+
+    if (op == 0xfe || op == 0xff)
+    {
+      pixel[0] = bytes[offset++];
+      pixel[1] = bytes[offset++];
+      pixel[2] = bytes[offset++];
+      if (op == 0xff)
+      {
+        pixel[3] = bytes[offset++];
+      }
+    }
+    else if ((op & 0xc0) == 0x00)
+    {
+      pixel = seen[op];
+    }
+    else if ((op & 0xc0) == 0x40)
+    {
+      pixel[0] = static_cast<uint8_t>(pixel[0] + ((op >> 4) & 3) - 2);
+      pixel[1] = static_cast<uint8_t>(pixel[1] + ((op >> 2) & 3) - 2);
+      pixel[2] = static_cast<uint8_t>(pixel[2] + (op & 3) - 2);
+    }
+    else if ((op & 0xc0) == 0x80)
+    {
+      const int dg     = (op & 0x3f) - 32;
+      const uint8_t rb = bytes[offset++];
+      pixel[0]         = static_cast<uint8_t>(pixel[0] + dg + ((rb >> 4) & 0xf) - 8);
+      pixel[1]         = static_cast<uint8_t>(pixel[1] + dg);
+      pixel[2]         = static_cast<uint8_t>(pixel[2] + dg + (rb & 0xf) - 8);
+    }
+    else
+    {
+      run = (op & 0x3f) + 1;
+    }
+
+    const size_t hash = static_cast<size_t>(pixel[0]) * 3U
+                      + static_cast<size_t>(pixel[1]) * 5U
+                      + static_cast<size_t>(pixel[2]) * 7U
+                      + static_cast<size_t>(pixel[3]) * 11U;
+    seen[hash % 64] = pixel;
+    for (; run > 0; --run)
+    {
+      output.insert(output.end(), pixel.begin(), pixel.end());
+    }
+  }
+  return output;
+}
+} // namespace
+
+SCENARIO("Pick an image encoder by extension", "[gfx][utils][image_sink]")
+{
+  using gfx::utils::image::Format;
+  using gfx::utils::image::format_for;
+
+  REQUIRE(format_for("frame.png") == Format::PNG);
+  REQUIRE(format_for("frame.jpg") == Format::JPEG);
+  REQUIRE(format_for("dir.d/frame.jpeg") == Format::JPEG);
+  REQUIRE(format_for("frame.ppm") == Format::PPM);
+  REQUIRE(format_for("frame.raw") == Format::Raw);
+  REQUIRE(format_for("frame.qoi") == Format::QOI);
+  REQUIRE_FALSE(format_for("frame.bmp").has_value());
+  REQUIRE_FALSE(format_for("frame").has_value());
+}
+
+SCENARIO("Encode images", "[gfx][utils][image_sink]")
+{
+  namespace image = gfx::utils::image;
+
+  GIVEN("three rows of two RGBA pixels")
+  {
+    const std::vector<uint8_t> pixels{
+        1,  2,  3,  4,  5,  6,  7,  8,  // top
+        9,  10, 11, 12, 13, 14, 15, 16, // middle
+        17, 18, 19, 20, 21, 22, 23, 24, // bottom
+    };
+    const gfx::Size size{2, 3};
+
+    WHEN("written raw and flipped")
+    {
+      const auto bytes = image::encode(image::Format::Raw, {pixels, size, 4, true});
+
+      THEN("the rows are reversed, the middle one stays")
+      {
+        REQUIRE(bytes
+                == std::vector<uint8_t>{17, 18, 19, 20, 21, 22, 23, 24,
+                                        9,  10, 11, 12, 13, 14, 15, 16,
+                                        1,  2,  3,  4,  5,  6,  7,  8});
+      }
+    }
+
+    WHEN("written as PPM")
+    {
+      const auto bytes = image::encode(image::Format::PPM, {pixels, size});
+      const std::string header{"P6\n2 3\n255\n"};
+
+      THEN("there is a header and alpha is dropped")
+      {
+        REQUIRE(std::string(bytes.begin(), std::next(bytes.begin(), 11)) == header);
+        REQUIRE(std::vector<uint8_t>(std::next(bytes.begin(), 11), bytes.end())
+                == std::vector<uint8_t>{1,  2,  3,  5,  6,  7,  9,  10, 11,
+                                        13, 14, 15, 17, 18, 19, 21, 22, 23});
+      }
+    }
+
+    WHEN("there are too few pixels for the size")
+    {
+      const std::span<const uint8_t> truncated{pixels.data(), 8};
+
+      THEN("nothing is encoded")
+      {
+        REQUIRE(image::encode(image::Format::Raw, {truncated, size}).empty());
+      }
+    }
+  }
+
+  GIVEN("opaque black after another colour")
+  {
+    const std::vector<uint8_t> pixels{40, 50, 60, 255, 0, 0, 0, 255};
+
+    WHEN("written as QOI")
+    {
+      const auto bytes = image::encode(image::Format::QOI, {pixels, gfx::Size{2, 1}});
+
+      THEN("black is not taken from the still empty colour index")
+      {
+        REQUIRE(decode_qoi(bytes, 2) == pixels);
+      }
+    }
+  }
+
+  GIVEN("a frame with runs, gradients and noise")
+  {
+    const gfx::Size size{96, 200};
+    std::vector<uint8_t> pixels(size.size() * 4);
+    uint32_t state{12345};
+    for (size_t index = 0; index < size.size(); ++index)
+    {
+      const size_t x = index % static_cast<size_t>(size.width);
+      const size_t y = index / static_cast<size_t>(size.width);
+      state          = state * 1664525U + 1013904223U;
+
+      pixels[index * 4]     = static_cast<uint8_t>(y < 50 ? 0 : x);
+      pixels[index * 4 + 1] = static_cast<uint8_t>(y < 100 ? y : state >> 24U);
+      pixels[index * 4 + 2] = static_cast<uint8_t>(x * 3 + y);
+      pixels[index * 4 + 3] = static_cast<uint8_t>(y < 150 ? 255 : state >> 16U);
+    }
+
+    WHEN("written as QOI")
+    {
+      const auto bytes = image::encode(image::Format::QOI, {pixels, size});
+
+      THEN("it decodes back to the same pixels")
+      {
+        REQUIRE(std::string(bytes.begin(), std::next(bytes.begin(), 4)) == "qoif");
+        REQUIRE(decode_qoi(bytes, size.size()) == pixels);
+        REQUIRE(std::vector<uint8_t>(std::prev(bytes.end(), 8), bytes.end())
+                == std::vector<uint8_t>{0, 0, 0, 0, 0, 0, 0, 1});
+      }
+    }
+
+    WHEN("rows are split across a pool")
+    {
+      gfx::utils::ThreadPool pool{3};
+
+      THEN("the output is the same as on one thread")
+      {
+        for (const auto format : {image::Format::Raw, image::Format::PPM})
+        {
+          REQUIRE(image::encode(format, {pixels, size, 4, true}, {.pool = &pool})
+                  == image::encode(format, {pixels, size, 4, true}));
+        }
+      }
+    }
+  }
+}
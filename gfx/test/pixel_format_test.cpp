@@ -0,0 +1,73 @@
+#include "graphics/pixel_format.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <GL/glew.h>
+
+#include <cstddef>
+
+SCENARIO("Pixel format descriptors", "[gfx][graphics][pixel_format]")
+{
+  using gfx::graphics::PixelFormat;
+  namespace pixel_format = gfx::graphics::pixel_format;
+
+  GIVEN("the single plane formats")
+  {
+    THEN("8 bit RGBA takes a quarter of what RGBA32F does")
+    {
+      REQUIRE(pixel_format::describe(PixelFormat::RGBA8).internalFormat == GL_RGBA8);
+      REQUIRE(pixel_format::describe(PixelFormat::RGBA8).bytesPerPixel * 4
+              == pixel_format::describe(PixelFormat::RGBA32F).bytesPerPixel);
+      REQUIRE(pixel_format::describe(PixelFormat::RGBA16F).type == GL_HALF_FLOAT);
+      REQUIRE(pixel_format::describe(PixelFormat::RG8).format == GL_RG);
+    }
+
+    THEN("they are one plane with the whole frame")
+    {
+      const auto planes = pixel_format::planes(PixelFormat::R8, gfx::Size{7, 3});
+      REQUIRE(planes.size() == 1);
+      REQUIRE(planes[0].stride == 7);
+      REQUIRE(pixel_format::frame_size(PixelFormat::RGBA16F, gfx::Size{4, 2}) == 64);
+      REQUIRE_FALSE(pixel_format::is_planar(PixelFormat::RGBA8));
+    }
+  }
+
+  GIVEN("the 4:2:0 formats of a 6x4 frame")
+  {
+    constexpr gfx::Size size{6, 4};
+
+    THEN("I420 is three R8 planes back to back")
+    {
+      const auto planes = pixel_format::planes(PixelFormat::I420, size);
+      REQUIRE(planes.size() == 3);
+      REQUIRE(planes[1].format == PixelFormat::R8);
+      REQUIRE(planes[1].size == gfx::Size{3, 2});
+      REQUIRE(planes[1].offset == 24);
+      REQUIRE(planes[2].offset == 30);
+      REQUIRE(pixel_format::frame_size(PixelFormat::I420, size) == 36);
+    }
+
+    THEN("NV12 is luma and interleaved chroma of the same size")
+    {
+      const auto planes = pixel_format::planes(PixelFormat::NV12, size);
+      REQUIRE(planes.size() == 2);
+      REQUIRE(planes[1].format == PixelFormat::RG8);
+      REQUIRE(planes[1].stride == 6);
+      REQUIRE(pixel_format::frame_size(PixelFormat::NV12, size) == 36);
+    }
+
+    THEN("odd sizes round the chroma up")
+    {
+      const auto planes = pixel_format::planes(PixelFormat::I420, gfx::Size{5, 3});
+      REQUIRE(planes[1].size == gfx::Size{3, 2});
+    }
+  }
+
+  THEN("a full mip chain ends at 1x1")
+  {
+    REQUIRE(pixel_format::mip_levels(gfx::Size{1, 1}) == 1);
+    REQUIRE(pixel_format::mip_levels(gfx::Size{256, 16}) == 9);
+    REQUIRE(pixel_format::mip_levels(gfx::Size{1920, 1080}) == 11);
+  }
+}
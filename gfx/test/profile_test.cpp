@@ -0,0 +1,115 @@
+#include "profile.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+SCENARIO("Log-linear duration histogram", "[gfx][utils][profile]")
+{
+  GIVEN("the values 1 to 1000")
+  {
+    gfx::utils::profile::Histogram histogram{};
+    for (uint64_t value = 1; value <= 1000; ++value) // NOLINT
+    {
+      histogram.add(value);
+    }
+
+    THEN("count, mean and max are exact")
+    {
+      const auto summary = histogram.summary();
+      REQUIRE(summary.count == 1000);
+      REQUIRE(summary.mean == Catch::Approx(500.5));
+      REQUIRE(summary.max == 1000);
+    }
+
+    THEN("percentiles are within a sixteenth")
+    {
+      const auto summary = histogram.summary();
+      REQUIRE(summary.p50 >= 500 - 500 / 16);
+      REQUIRE(summary.p50 <= 500 + 500 / 16);
+      REQUIRE(summary.p99 >= 990 - 990 / 16);
+      REQUIRE(summary.p99 <= 1000);
+    }
+
+    WHEN("reset")
+    {
+      histogram.reset();
+
+      THEN("it is empty")
+      {
+        REQUIRE(histogram.summary().count == 0);
+        REQUIRE(histogram.percentile(0.5) == 0);
+      }
+    }
+  }
+
+  GIVEN("small values")
+  {
+    gfx::utils::profile::Histogram histogram{};
+    histogram.add(0);
+    histogram.add(3);
+    histogram.add(7);
+
+    THEN("they are kept exactly")
+    {
+      REQUIRE(histogram.percentile(0.0) == 0);
+      REQUIRE(histogram.percentile(0.5) == 3);
+      REQUIRE(histogram.percentile(1.0) == 7);
+    }
+  }
+
+  GIVEN("values added from several threads")
+  {
+    gfx::utils::profile::Histogram histogram{};
+    std::vector<std::thread> threads{};
+    for (int thread = 0; thread < 4; ++thread)
+    {
+      threads.emplace_back([&histogram] {
+        for (uint64_t value = 0; value < 10'000; ++value) // NOLINT
+        {
+          histogram.add(value);
+        }
+      });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    THEN("none are lost")
+    {
+      REQUIRE(histogram.summary().count == 40'000);
+      REQUIRE(histogram.summary().max == 9'999);
+    }
+  }
+}
+
+SCENARIO("Profile zones", "[gfx][utils][profile]")
+{
+  GIVEN("a zone")
+  {
+    auto& zone = gfx::utils::profile::zone("profile_test");
+
+    THEN("the same name returns the same zone")
+    {
+      REQUIRE(&gfx::utils::profile::zone("profile_test") == &zone);
+    }
+
+    WHEN("a scope ends")
+    {
+      zone.histogram.reset();
+      {
+        const gfx::utils::profile::Scope scope{zone};
+      }
+
+      THEN("it records one duration when compiled in")
+      {
+        const uint64_t expected = gfx::utils::profile::compiled ? 1 : 0;
+        REQUIRE(zone.histogram.summary().count == expected);
+      }
+    }
+  }
+}
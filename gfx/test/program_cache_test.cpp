@@ -0,0 +1,111 @@
+#include "graphics/program_cache.hpp"
+#include "graphics/shader.hpp"
+#include "graphics/window.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+constexpr const char* vertex{"#version 330 core\n"
+                             "void main() { gl_Position = vec4(0.0); }\n"};
+
+constexpr const char* fragment{"#version 330 core\n"
+                               "out vec4 color;\n"
+                               "void main() { color = vec4(1.0); }\n"};
+} // namespace
+
+SCENARIO("Program cache directory", "[gfx][graphics][program_cache]")
+{
+  GIVEN("XDG_CACHE_HOME is set")
+  {
+    const char* previous = std::getenv("XDG_CACHE_HOME");
+    const std::string restore{previous == nullptr ? "" : previous};
+    setenv("XDG_CACHE_HOME", "/var/cache/user", 1);
+
+    THEN("programs are kept below it")
+    {
+      REQUIRE(gfx::graphics::program_cache::default_directory()
+              == std::filesystem::path{"/var/cache/user/gfx/programs"});
+    }
+
+    if (previous == nullptr)
+    {
+      unsetenv("XDG_CACHE_HOME");
+    }
+    else
+    {
+      setenv("XDG_CACHE_HOME", restore.c_str(), 1);
+    }
+  }
+}
+
+// Needs an OpenGL context, hidden from the default run, see streaming_texture_test
+SCENARIO("Program binaries are cached on disk", "[gfx][graphics][program_cache][.gl]")
+{
+  namespace program_cache = gfx::graphics::program_cache;
+
+  const gfx::graphics::Window window{"program_cache_test",
+                                     gfx::Size{64, 64},
+                                     gfx::graphics::Window::Mode::Headless};
+
+  const auto directory = std::filesystem::temp_directory_path()
+                       / "gfx_program_cache_test";
+  std::filesystem::remove_all(directory);
+  program_cache::enable(directory);
+
+  GIVEN("a program compiled once")
+  {
+    const program_cache::Stats before = program_cache::stats();
+    const gfx::graphics::Shader first{vertex, fragment};
+    const program_cache::Stats compiled = program_cache::stats();
+
+    THEN("it was a miss and left one entry")
+    {
+      REQUIRE(compiled.misses == before.misses + 1);
+      REQUIRE(compiled.hits == before.hits);
+      REQUIRE(std::distance(std::filesystem::directory_iterator{directory},
+                            std::filesystem::directory_iterator{})
+              == 1);
+    }
+
+    WHEN("the same program is created again")
+    {
+      const gfx::graphics::Shader second{vertex, fragment};
+
+      THEN("it is loaded from the cache")
+      {
+        REQUIRE(program_cache::stats().hits == compiled.hits + 1);
+        REQUIRE(program_cache::stats().misses == compiled.misses);
+      }
+    }
+
+    WHEN("the entry is corrupted")
+    {
+      for (const auto& entry : std::filesystem::directory_iterator{directory})
+      {
+        std::ofstream{entry.path(), std::ios::binary | std::ios::in}
+            .seekp(24)
+            .write("garbage", 7);
+      }
+
+      const gfx::graphics::Shader second{vertex, fragment};
+
+      THEN("it is compiled again and replaced")
+      {
+        REQUIRE(program_cache::stats().rejected == compiled.rejected + 1);
+
+        const gfx::graphics::Shader third{vertex, fragment};
+        REQUIRE(program_cache::stats().hits == compiled.hits + 1);
+      }
+    }
+  }
+
+  program_cache::disable();
+  std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,120 @@
+#include "graphics/quad_batch.hpp"
+#include "graphics/window.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <GL/glew.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+constexpr GLsizei side{64};
+
+std::array<uint8_t, 4> read_pixel(GLint x, GLint y)
+{
+  std::array<uint8_t, 4> pixel{};
+  glReadPixels(x, y, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel.data());
+  return pixel;
+}
+} // namespace
+
+// Needs an OpenGL context, hidden from the default run, see streaming_texture_test
+SCENARIO("Instanced quad batch", "[gfx][graphics][quad_batch][.gl]")
+{
+  const gfx::graphics::Window window{"quad_batch_test",
+                                     gfx::Size{side, side},
+                                     gfx::graphics::Window::Mode::Headless};
+
+  GIVEN("a render target and a texture array with a green second layer")
+  {
+    unsigned int target{0};
+    glGenTextures(1, &target);
+    glBindTexture(GL_TEXTURE_2D, target);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, side, side);
+
+    unsigned int framebuffer{0};
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER,
+                           GL_COLOR_ATTACHMENT0,
+                           GL_TEXTURE_2D,
+                           target,
+                           0);
+    glViewport(0, 0, side, side);
+
+    std::vector<uint8_t> layers(4 * 4 * 2 * 4, 0); // NOLINT
+    for (size_t texel = 16; texel < 32; ++texel)    // NOLINT
+    {
+      layers[texel * 4 + 1] = 0xFF; // NOLINT
+      layers[texel * 4 + 3] = 0xFF; // NOLINT
+    }
+
+    unsigned int array{0};
+    glGenTextures(1, &array);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, array);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, 4, 4, 2);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY,
+                    0,
+                    0,
+                    0,
+                    0,
+                    4,
+                    4,
+                    2,
+                    GL_RGBA,
+                    GL_UNSIGNED_BYTE,
+                    layers.data());
+
+    gfx::graphics::QuadBatch batch{4, 2};
+
+    WHEN("an untextured and a textured quad are drawn for more frames than regions")
+    {
+      for (int frame = 0; frame < 5; ++frame)
+      {
+        glClear(GL_COLOR_BUFFER_BIT);
+        REQUIRE(batch.add({.x         = -0.5F,
+                           .halfWidth = 0.5F,
+                           .color     = {0xFF, 0, 0, 0xFF}}));
+        REQUIRE(batch.add({.x = 0.5F, .halfWidth = 0.5F, .layer = 1}));
+        REQUIRE(batch.size() == 2);
+        batch.draw(array);
+      }
+
+      THEN("each half has its colour and the batch is empty")
+      {
+        REQUIRE(batch.size() == 0);
+        REQUIRE(read_pixel(side / 4, side / 2)
+                == std::array<uint8_t, 4>{0xFF, 0, 0, 0xFF});
+        REQUIRE(read_pixel(3 * side / 4, side / 2)
+                == std::array<uint8_t, 4>{0, 0xFF, 0, 0xFF});
+      }
+    }
+
+    WHEN("more quads than the capacity are added")
+    {
+      for (size_t quad = 0; quad < batch.capacity(); ++quad)
+      {
+        REQUIRE(batch.add({}));
+      }
+
+      THEN("the extra one is refused until the next draw")
+      {
+        REQUIRE_FALSE(batch.add({}));
+        batch.draw();
+        REQUIRE(batch.add({}));
+      }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &array);
+    glDeleteTextures(1, &target);
+  }
+}
@@ -0,0 +1,113 @@
+#include "graphics/render_target.hpp"
+#include "graphics/shader.hpp"
+#include "graphics/window.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <GL/glew.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+constexpr const char* vertex{R"(#version 330 core
+uniform float uDepth;
+void main()
+{
+  vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 4.0 - 1.0;
+  gl_Position = vec4(corner, uDepth, 1.0);
+}
+)"};
+
+constexpr const char* fragment{R"(#version 330 core
+uniform vec4 uColor;
+layout(location = 0) out vec4 first;
+layout(location = 1) out vec4 second;
+void main()
+{
+  first  = uColor;
+  second = uColor.bgra;
+}
+)"};
+
+constexpr gfx::Size size{300, 200};
+
+using Pixel = std::array<uint8_t, 4>;
+
+Pixel pixel_at(const std::vector<uint8_t>& pixels, size_t x, size_t y)
+{
+  const size_t offset = (y * size.width + x) * 4;
+  return {pixels[offset], pixels[offset + 1], pixels[offset + 2], pixels[offset + 3]};
+}
+} // namespace
+
+// Needs an OpenGL context, hidden from the default run, see streaming_texture_test
+SCENARIO("Offscreen rendering into framebuffer objects",
+         "[gfx][graphics][render_target][.gl]")
+{
+  const gfx::graphics::Window window{"render_target_test",
+                                     gfx::Size{1, 1},
+                                     gfx::graphics::Window::Mode::Offscreen};
+
+  GIVEN("a target larger than the window with two colour attachments")
+  {
+    const gfx::graphics::RenderTarget target{size, 2};
+    REQUIRE(target.colorAttachments() == 2);
+
+    std::vector<uint8_t> pixels(size.width * size.height * 4);
+
+    WHEN("it is cleared")
+    {
+      target.clear(0.0F, 0.0F, 1.0F, 1.0F);
+      target.read(pixels, 1);
+
+      THEN("every attachment has the clear colour")
+      {
+        REQUIRE(pixel_at(pixels, 0, 0) == Pixel{0, 0, 0xFF, 0xFF});
+        REQUIRE(pixel_at(pixels, 299, 199) == Pixel{0, 0, 0xFF, 0xFF});
+      }
+    }
+
+    WHEN("two triangles are drawn with depth testing")
+    {
+      const gfx::graphics::Shader shader{vertex, fragment};
+      unsigned int vao{0};
+      glGenVertexArrays(1, &vao);
+      glBindVertexArray(vao);
+
+      target.bind();
+      target.clear(0.0F, 0.0F, 0.0F, 1.0F);
+      glEnable(GL_DEPTH_TEST);
+      glDisable(GL_BLEND);
+      shader.use();
+
+      shader.setUniform("uDepth", 0.0F);
+      shader.setUniform("uColor", std::array<float, 4>{1.0F, 0.0F, 0.0F, 1.0F});
+      glDrawArrays(GL_TRIANGLES, 0, 3);
+
+      shader.setUniform("uDepth", 0.5F);
+      shader.setUniform("uColor", std::array<float, 4>{0.0F, 1.0F, 0.0F, 1.0F});
+      glDrawArrays(GL_TRIANGLES, 0, 3);
+
+      glDisable(GL_DEPTH_TEST);
+      glEnable(GL_BLEND);
+      gfx::graphics::RenderTarget::unbind(gfx::Size{1, 1});
+
+      THEN("the nearer one covers the whole target, in both outputs")
+      {
+        target.read(pixels, 0);
+        REQUIRE(pixel_at(pixels, 0, 0) == Pixel{0xFF, 0, 0, 0xFF});
+        REQUIRE(pixel_at(pixels, 299, 199) == Pixel{0xFF, 0, 0, 0xFF});
+
+        target.read(pixels, 1);
+        REQUIRE(pixel_at(pixels, 150, 100) == Pixel{0, 0, 0xFF, 0xFF});
+      }
+
+      glDeleteVertexArrays(1, &vao);
+    }
+  }
+}
@@ -0,0 +1,143 @@
+#include "graphics/shader.hpp"
+#include "graphics/uniform_buffer.hpp"
+#include "graphics/window.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <GL/glew.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+constexpr const char* vertex{R"(#version 330 core
+uniform vec2 uOffsets[2];
+void main()
+{
+  vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 4.0 - 1.0;
+  gl_Position = vec4(corner + uOffsets[0] + uOffsets[1], 0.0, 1.0);
+}
+)"};
+
+constexpr const char* fragment{R"(#version 330 core
+layout(std140) uniform Frame
+{
+  mat4 transform;
+  vec4 color;
+  vec2 scale;
+  float time;
+} frame;
+uniform float uScale;
+uniform vec4 uTint;
+out vec4 fragColor;
+void main()
+{
+  vec4 color = frame.transform * frame.color * frame.scale.x * frame.time;
+  fragColor  = vec4(color.rgb * uScale, 1.0) + uTint;
+}
+)"};
+
+struct Frame
+{
+    gfx::graphics::std140::mat4 transform;
+    gfx::graphics::std140::vec4 color;
+    gfx::graphics::std140::vec2 scale;
+    float time;
+};
+
+// A float right after a vec3 shares its 16 bytes in std140
+struct Light
+{
+    alignas(16) gfx::graphics::std140::vec3 position;
+    float intensity;
+    alignas(16) gfx::graphics::std140::vec3 color;
+};
+
+static_assert(offsetof(Light, position) == 0);
+static_assert(offsetof(Light, intensity) == 12);
+static_assert(offsetof(Light, color) == 16);
+static_assert(sizeof(Light) == 32);
+
+constexpr gfx::graphics::std140::mat4 identity{
+    {{{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}}}
+};
+} // namespace
+
+// Needs an OpenGL context, hidden from the default run, see streaming_texture_test
+SCENARIO("Shader uniforms and uniform blocks", "[gfx][graphics][shader][.gl]")
+{
+  const gfx::graphics::Window window{"shader_test",
+                                     gfx::Size{16, 16},
+                                     gfx::graphics::Window::Mode::Headless};
+
+  GIVEN("a program with plain uniforms and a std140 block")
+  {
+    const gfx::graphics::Shader shader{vertex, fragment};
+    shader.use();
+
+    THEN("active uniforms have locations, arrays also without [0]")
+    {
+      REQUIRE(shader.location("uScale") >= 0);
+      REQUIRE(shader.location("uTint") >= 0);
+      REQUIRE(shader.location("uOffsets") == shader.location("uOffsets[0]"));
+      REQUIRE(shader.location("uOffsets[1]") >= 0);
+      REQUIRE(shader.location("uMissing") == -1);
+      REQUIRE(shader.location("transform") == -1);
+    }
+
+    THEN("the C++ mirror of the block has the std140 size")
+    {
+      REQUIRE(shader.uniformBlockSize("Frame") == sizeof(Frame));
+      REQUIRE(shader.uniformBlockSize("Missing") == 0);
+    }
+
+    WHEN("uniforms are set by name and the block by one buffer write")
+    {
+      shader.setUniform("uScale", 1.0F);
+      shader.setUniform("uTint", std::array<float, 4>{0.0F, 0.0F, 1.0F, 0.0F});
+      shader.setUniform("uOffsets[1]", std::array<float, 2>{0.0F, 0.0F});
+      shader.setUniform("uMissing", 2.0F);
+
+      gfx::graphics::UniformBuffer<Frame> frame{};
+      frame.bind(3);
+      shader.bindUniformBlock("Frame", 3);
+      frame.update({identity, {0.0F, 1.0F, 0.0F, 1.0F}, {1.0F, 1.0F}, 1.0F});
+
+      unsigned int target{0};
+      glGenTextures(1, &target);
+      glBindTexture(GL_TEXTURE_2D, target);
+      glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, 16, 16);
+
+      unsigned int framebuffer{0};
+      glGenFramebuffers(1, &framebuffer);
+      glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+      glFramebufferTexture2D(GL_FRAMEBUFFER,
+                             GL_COLOR_ATTACHMENT0,
+                             GL_TEXTURE_2D,
+                             target,
+                             0);
+      glViewport(0, 0, 16, 16);
+
+      unsigned int vao{0};
+      glGenVertexArrays(1, &vao);
+      glBindVertexArray(vao);
+      glDrawArrays(GL_TRIANGLES, 0, 3);
+
+      std::array<uint8_t, 4> pixel{};
+      glReadPixels(8, 8, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel.data());
+
+      THEN("the block colour and the tint are drawn")
+      {
+        REQUIRE(pixel == std::array<uint8_t, 4>{0, 0xFF, 0xFF, 0xFF});
+      }
+
+      glDeleteVertexArrays(1, &vao);
+      glBindFramebuffer(GL_FRAMEBUFFER, 0);
+      glDeleteFramebuffers(1, &framebuffer);
+      glDeleteTextures(1, &target);
+    }
+  }
+}
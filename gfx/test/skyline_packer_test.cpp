@@ -0,0 +1,120 @@
+#include "graphics/skyline_packer.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+using Rect = gfx::graphics::SkylinePacker::Rect;
+
+bool overlap(const Rect& lhs, const Rect& rhs)
+{
+  return lhs.x < rhs.x + rhs.width && rhs.x < lhs.x + lhs.width
+      && lhs.y < rhs.y + rhs.height && rhs.y < lhs.y + lhs.height;
+}
+} // namespace
+
+SCENARIO("Skyline rectangle packing", "[gfx][graphics][skyline_packer]")
+{
+  GIVEN("an empty 64x64 area")
+  {
+    gfx::graphics::SkylinePacker packer{gfx::Size{64, 64}};
+
+    THEN("rectangles larger than the area or empty do not fit")
+    {
+      REQUIRE_FALSE(packer.insert(65, 1));
+      REQUIRE_FALSE(packer.insert(1, 65));
+      REQUIRE_FALSE(packer.insert(0, 8));
+    }
+
+    WHEN("a row is filled")
+    {
+      const auto first  = packer.insert(32, 16);
+      const auto second = packer.insert(32, 8);
+
+      THEN("they sit side by side on the bottom")
+      {
+        REQUIRE(first->x == 0);
+        REQUIRE(first->y == 0);
+        REQUIRE(second->x == 32);
+        REQUIRE(second->y == 0);
+      }
+
+      AND_THEN("the next one goes on the lower of the two")
+      {
+        const auto third = packer.insert(32, 8);
+        REQUIRE(third->x == 32);
+        REQUIRE(third->y == 8);
+
+        const auto wide = packer.insert(64, 8);
+        REQUIRE(wide->x == 0);
+        REQUIRE(wide->y == 16);
+      }
+    }
+
+    WHEN("it is filled with 8x8 tiles")
+    {
+      std::vector<Rect> placed{};
+      while (const auto rect = packer.insert(8, 8))
+      {
+        placed.push_back(*rect);
+      }
+
+      THEN("all 64 fit without overlapping and nothing else does")
+      {
+        REQUIRE(placed.size() == 64);
+        REQUIRE(packer.occupancy() == Catch::Approx(1.0));
+        for (size_t lhs = 0; lhs < placed.size(); ++lhs)
+        {
+          for (size_t rhs = lhs + 1; rhs < placed.size(); ++rhs)
+          {
+            REQUIRE_FALSE(overlap(placed[lhs], placed[rhs]));
+          }
+        }
+      }
+
+      AND_WHEN("it is cleared")
+      {
+        packer.clear();
+
+        THEN("the whole area is free again")
+        {
+          REQUIRE(packer.occupancy() == Catch::Approx(0.0));
+          REQUIRE(packer.insert(64, 64));
+        }
+      }
+    }
+
+    WHEN("mixed sizes are inserted until one does not fit")
+    {
+      std::vector<Rect> placed{};
+      for (size_t index = 0;; ++index)
+      {
+        const auto rect = packer.insert(3 + index * 7 % 13, 2 + index * 5 % 11);
+        if (!rect)
+        {
+          break;
+        }
+        placed.push_back(*rect);
+      }
+
+      THEN("every rectangle is inside the area and none overlap")
+      {
+        REQUIRE(placed.size() > 10);
+        for (size_t lhs = 0; lhs < placed.size(); ++lhs)
+        {
+          REQUIRE(placed[lhs].x + placed[lhs].width <= 64);
+          REQUIRE(placed[lhs].y + placed[lhs].height <= 64);
+          for (size_t rhs = lhs + 1; rhs < placed.size(); ++rhs)
+          {
+            REQUIRE_FALSE(overlap(placed[lhs], placed[rhs]));
+          }
+        }
+      }
+    }
+  }
+}
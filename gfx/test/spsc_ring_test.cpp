@@ -0,0 +1,77 @@
+#include "detail/spsc_ring.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <thread>
+
+SCENARIO("Bounded single producer single consumer ring", "[gfx][utils][spsc_ring]")
+{
+  GIVEN("a ring with a capacity that is not a power of two")
+  {
+    gfx::utils::detail::SpscRing<int> ring{3};
+
+    THEN("capacity is rounded up")
+    {
+      REQUIRE(ring.capacity() == 4);
+      REQUIRE(ring.empty());
+    }
+
+    WHEN("pushing more values than fit")
+    {
+      REQUIRE(ring.push(1));
+      REQUIRE(ring.push(2));
+      REQUIRE(ring.push(3));
+      REQUIRE(ring.push(4));
+
+      THEN("push fails without overwriting")
+      {
+        REQUIRE_FALSE(ring.push(5));
+        REQUIRE(ring.pop() == 1);
+        REQUIRE(ring.push(5));
+      }
+    }
+
+    WHEN("popping from an empty ring")
+    {
+      THEN("nothing is returned")
+      {
+        REQUIRE_FALSE(ring.pop().has_value());
+      }
+    }
+  }
+
+  GIVEN("a producer and a consumer thread")
+  {
+    constexpr size_t numValues{100000};
+    gfx::utils::detail::SpscRing<size_t> ring{64};
+
+    std::thread producer{[&ring] {
+      for (size_t value = 0; value < numValues;)
+      {
+        if (ring.push(value))
+        {
+          ++value;
+        }
+      }
+    }};
+
+    size_t expected{0};
+    bool ordered{true};
+    while (expected < numValues)
+    {
+      if (auto value = ring.pop())
+      {
+        ordered = ordered && *value == expected;
+        ++expected;
+      }
+    }
+    producer.join();
+
+    THEN("values arrive in order")
+    {
+      REQUIRE(ordered);
+      REQUIRE(ring.empty());
+    }
+  }
+}
@@ -0,0 +1,69 @@
+#include "graphics/streaming_texture.hpp"
+#include "graphics/window.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Needs an OpenGL context, hidden from the default run. Under software GL e.g.
+// LIBGL_ALWAYS_SOFTWARE=1 MESA_GL_VERSION_OVERRIDE=4.6 xvfb-run unit_tests [gl]
+SCENARIO("Streaming texture uploads through a pixel buffer ring",
+         "[gfx][graphics][streaming_texture][.gl]")
+{
+  gfx::graphics::Window window{"streaming_texture_test",
+                               gfx::Size{64, 64},
+                               gfx::graphics::Window::Mode::Headless};
+
+  GIVEN("a triple buffered texture")
+  {
+    constexpr gfx::Size size{64, 32};
+    gfx::graphics::StreamingTexture texture{size, 3};
+
+    REQUIRE(texture.depth() == 3);
+    REQUIRE(texture.frameSize() == size.width * size.height * 4);
+
+    WHEN("more frames than slots are uploaded")
+    {
+      std::vector<uint8_t> readback(texture.frameSize());
+      bool matches{true};
+
+      for (int frame = 0; frame < 8; ++frame)
+      {
+        std::vector<uint8_t> pixels(texture.frameSize(), static_cast<uint8_t>(frame));
+        pixels.front() = 0xFF; // NOLINT
+        texture.upload(pixels);
+
+        texture.bind();
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, readback.data());
+        matches = matches && readback == pixels;
+      }
+
+      THEN("the current texture always holds the last frame")
+      {
+        REQUIRE(matches);
+        REQUIRE(glGetError() == GL_NO_ERROR);
+      }
+    }
+
+    WHEN("a frame is written in place")
+    {
+      auto pixels = texture.acquire();
+      std::fill(pixels.begin(), pixels.end(), uint8_t{42}); // NOLINT
+      texture.commit();
+
+      THEN("it is uploaded without a copy")
+      {
+        std::vector<uint8_t> readback(texture.frameSize());
+        texture.bind();
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, readback.data());
+        REQUIRE(readback == std::vector<uint8_t>(texture.frameSize(), 42));
+      }
+    }
+  }
+}
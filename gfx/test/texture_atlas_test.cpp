@@ -0,0 +1,143 @@
+#include "graphics/quad_batch.hpp"
+#include "graphics/render_target.hpp"
+#include "graphics/texture_atlas.hpp"
+#include "graphics/window.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <GL/glew.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+using Pixel = std::array<uint8_t, 4>;
+
+constexpr gfx::Size layerSize{32, 32};
+
+std::vector<uint8_t> solid(size_t width, size_t height, Pixel color)
+{
+  std::vector<uint8_t> pixels{};
+  for (size_t index = 0; index < width * height; ++index)
+  {
+    pixels.insert(pixels.end(), color.begin(), color.end());
+  }
+  return pixels;
+}
+
+// Texel of 'layer', read back from the whole array
+Pixel texel(const gfx::graphics::TextureAtlas& atlas, size_t layer, size_t x, size_t y)
+{
+  const size_t width  = layerSize.width;
+  const size_t height = layerSize.height;
+
+  std::vector<uint8_t> texels(width * height * atlas.layers() * 4);
+  atlas.bind();
+  glGetTexImage(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+
+  const size_t offset = ((layer * height + y) * width + x) * 4;
+  return {texels[offset], texels[offset + 1], texels[offset + 2], texels[offset + 3]};
+}
+} // namespace
+
+// Needs an OpenGL context, hidden from the default run, see streaming_texture_test
+SCENARIO("Texture atlas in array layers", "[gfx][graphics][texture_atlas][.gl]")
+{
+  const gfx::graphics::Window window{"texture_atlas_test",
+                                     gfx::Size{1, 1},
+                                     gfx::graphics::Window::Mode::Offscreen};
+
+  GIVEN("an atlas of two small layers")
+  {
+    gfx::graphics::TextureAtlas atlas{layerSize, 2};
+
+    constexpr Pixel red{0xFF, 0, 0, 0xFF};
+    constexpr Pixel green{0, 0xFF, 0, 0xFF};
+
+    WHEN("images are added until the first layer is full")
+    {
+      const auto first  = atlas.add(gfx::Size{20, 20}, solid(20, 20, red));
+      const auto second = atlas.add(gfx::Size{20, 20}, solid(20, 20, green));
+
+      THEN("the second one goes to the next layer")
+      {
+        REQUIRE(first->layer == 0);
+        REQUIRE(second->layer == 1);
+        REQUIRE_FALSE(atlas.add(gfx::Size{31, 31}, solid(31, 31, red)));
+      }
+
+      THEN("empty images are rejected")
+      {
+        REQUIRE_FALSE(atlas.add(gfx::Size{0, 4}, solid(0, 4, red)));
+        REQUIRE_FALSE(atlas.add(gfx::Size{4, 0}, solid(4, 0, red)));
+      }
+
+      THEN("regions skip the border and have matching UV rects")
+      {
+        REQUIRE(first->x == 1);
+        REQUIRE(first->y == 1);
+        REQUIRE(first->uv[0] == Catch::Approx(1.0F / 32.0F));
+        REQUIRE(first->uv[3] == Catch::Approx(21.0F / 32.0F));
+      }
+
+      THEN("the border repeats the edge texels")
+      {
+        REQUIRE(texel(atlas, 0, 0, 0) == red);
+        REQUIRE(texel(atlas, 0, 21, 21) == red);
+        REQUIRE(texel(atlas, 0, 22, 22) == Pixel{0, 0, 0, 0});
+      }
+
+      AND_WHEN("a region is updated")
+      {
+        atlas.update(*first, solid(20, 20, green));
+
+        THEN("only its texels change")
+        {
+          REQUIRE(texel(atlas, 0, 10, 10) == green);
+          REQUIRE(texel(atlas, 0, 0, 0) == green);
+          REQUIRE(texel(atlas, 0, 22, 22) == Pixel{0, 0, 0, 0});
+        }
+      }
+
+      AND_WHEN("a quad batch draws the regions from the bound array")
+      {
+        const gfx::graphics::RenderTarget target{gfx::Size{16, 16}, 1, false};
+        target.bind();
+        target.clear(0.0F, 0.0F, 0.0F, 1.0F);
+
+        gfx::graphics::QuadBatch batch{2};
+        batch.add({.x         = -0.5F,
+                   .halfWidth = 0.5F,
+                   .layer     = static_cast<float>(first->layer),
+                   .uv        = first->uv});
+        batch.add({.x         = 0.5F,
+                   .halfWidth = 0.5F,
+                   .layer     = static_cast<float>(second->layer),
+                   .uv        = second->uv});
+        batch.draw(atlas.get());
+
+        std::vector<uint8_t> pixels(16 * 16 * 4);
+        target.read(pixels);
+
+        THEN("each quad shows its own image")
+        {
+          REQUIRE(Pixel{pixels[(8 * 16 + 2) * 4],
+                        pixels[(8 * 16 + 2) * 4 + 1],
+                        pixels[(8 * 16 + 2) * 4 + 2],
+                        0xFF}
+                  == red);
+          REQUIRE(Pixel{pixels[(8 * 16 + 13) * 4],
+                        pixels[(8 * 16 + 13) * 4 + 1],
+                        pixels[(8 * 16 + 13) * 4 + 2],
+                        0xFF}
+                  == green);
+        }
+      }
+    }
+  }
+}
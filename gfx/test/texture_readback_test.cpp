@@ -0,0 +1,78 @@
+#include "graphics/texture.hpp"
+#include "graphics/utils/graphics_dump.hpp"
+#include "graphics/utils/texture_readback.hpp"
+#include "graphics/window.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::vector<char> contents(const std::filesystem::path& path)
+{
+  std::ifstream file{path, std::ios::binary};
+  return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+} // namespace
+
+// Needs an OpenGL context, hidden from the default run, see streaming_texture_test
+SCENARIO("Asynchronous texture readback", "[gfx][graphics][texture_readback][.gl]")
+{
+  const gfx::graphics::Window window{"texture_readback_test",
+                                     gfx::Size{64, 64},
+                                     gfx::graphics::Window::Mode::Headless};
+
+  GIVEN("a texture and a readback with fewer slots than dumps")
+  {
+    constexpr gfx::Size size{32, 16};
+    // Every row differs, a flipped or shifted image does not match
+    std::vector<uint8_t> pixels(size.width * size.height * 4);
+    for (size_t index = 0; index < pixels.size(); ++index)
+    {
+      pixels[index] = static_cast<uint8_t>(index / 7);
+    }
+    const gfx::graphics::Texture texture{size, pixels.data()};
+
+    const auto directory = std::filesystem::temp_directory_path()
+                         / "gfx_texture_readback_test";
+    std::filesystem::create_directories(directory);
+
+    WHEN("every frame is dumped")
+    {
+      gfx::utils::TextureReadback readback{size, 2};
+      for (int frame = 0; frame < 5; ++frame)
+      {
+        readback.dump((directory / (std::to_string(frame) + ".qoi")).string(),
+                      texture.get());
+      }
+      readback.flush();
+
+      gfx::utils::dump_texture((directory / "blocking.qoi").string(),
+                               texture.get(),
+                               size.width,
+                               size.height);
+
+      THEN("all files match what the blocking dump writes")
+      {
+        REQUIRE(readback.failed() == 0);
+
+        const std::vector<char> expected = contents(directory / "blocking.qoi");
+        REQUIRE_FALSE(expected.empty());
+        for (int frame = 0; frame < 5; ++frame)
+        {
+          REQUIRE(contents(directory / (std::to_string(frame) + ".qoi")) == expected);
+        }
+      }
+    }
+
+    std::filesystem::remove_all(directory);
+  }
+}
@@ -0,0 +1,115 @@
+#include "graphics/pixel_format.hpp"
+#include "graphics/planar_texture.hpp"
+#include "graphics/texture.hpp"
+#include "graphics/window.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+std::vector<uint8_t> read_level(const gfx::graphics::Texture& texture,
+                                GLint level,
+                                GLenum format,
+                                size_t bytes)
+{
+  std::vector<uint8_t> texels(bytes);
+  texture.bind();
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glGetTexImage(GL_TEXTURE_2D, level, format, GL_UNSIGNED_BYTE, texels.data());
+  return texels;
+}
+} // namespace
+
+// Needs an OpenGL context, hidden from the default run, see streaming_texture_test
+SCENARIO("Textures from pixel formats", "[gfx][graphics][texture][.gl]")
+{
+  const gfx::graphics::Window window{"texture_test",
+                                     gfx::Size{1, 1},
+                                     gfx::graphics::Window::Mode::Offscreen};
+
+  using gfx::graphics::PixelFormat;
+
+  GIVEN("an R8 texture with an odd width")
+  {
+    std::vector<uint8_t> pixels(7 * 3);
+    std::iota(pixels.begin(), pixels.end(), uint8_t{0});
+
+    const gfx::graphics::Texture texture{gfx::Size{7, 3},
+                                         PixelFormat::R8,
+                                         pixels.data()};
+
+    THEN("its storage is immutable with one byte per pixel")
+    {
+      texture.bind();
+      GLint immutable{0};
+      GLint internalFormat{0};
+      glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_IMMUTABLE_FORMAT, &immutable);
+      glGetTexLevelParameteriv(GL_TEXTURE_2D,
+                               0,
+                               GL_TEXTURE_INTERNAL_FORMAT,
+                               &internalFormat);
+      REQUIRE(immutable == GL_TRUE);
+      REQUIRE(internalFormat == GL_R8);
+      REQUIRE(texture.levels() == 1);
+    }
+
+    THEN("the unaligned rows are uploaded tightly packed")
+    {
+      REQUIRE(read_level(texture, 0, GL_RED, pixels.size()) == pixels);
+    }
+  }
+
+  GIVEN("an RGBA8 texture with a mip chain")
+  {
+    const std::vector<uint8_t> pixels(8 * 8 * 4, 0x80);
+    const gfx::graphics::Texture texture{gfx::Size{8, 8},
+                                         PixelFormat::RGBA8,
+                                         pixels.data(),
+                                         true};
+
+    THEN("every level down to 1x1 is generated on upload")
+    {
+      REQUIRE(texture.levels() == 4);
+      REQUIRE(read_level(texture, 3, GL_RGBA, 4) == std::vector<uint8_t>(4, 0x80));
+    }
+
+    AND_WHEN("it is uploaded again")
+    {
+      const std::vector<uint8_t> white(8 * 8 * 4, 0xFF);
+      texture.upload(white.data());
+
+      THEN("the chain follows")
+      {
+        REQUIRE(read_level(texture, 3, GL_RGBA, 4) == std::vector<uint8_t>(4, 0xFF));
+      }
+    }
+  }
+
+  GIVEN("an I420 frame of 6x4")
+  {
+    constexpr gfx::Size size{6, 4};
+    const gfx::graphics::PlanarTexture frame{size, PixelFormat::I420};
+
+    std::vector<uint8_t> bytes(frame.frameSize());
+    std::iota(bytes.begin(), bytes.end(), uint8_t{0});
+    frame.upload(bytes);
+
+    THEN("each plane holds its part of the frame")
+    {
+      REQUIRE(frame.planes() == 3);
+      REQUIRE(frame.plane(1).size() == gfx::Size{3, 2});
+      REQUIRE(read_level(frame.plane(0), 0, GL_RED, 24)
+              == std::vector<uint8_t>(bytes.begin(), bytes.begin() + 24));
+      REQUIRE(read_level(frame.plane(2), 0, GL_RED, 6)
+              == std::vector<uint8_t>(bytes.begin() + 30, bytes.end()));
+    }
+  }
+}
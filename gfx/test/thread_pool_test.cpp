@@ -0,0 +1,54 @@
+#include "thread_pool.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstddef>
+
+SCENARIO("Tasks run on a work stealing pool", "[gfx][utils][thread_pool]")
+{
+  GIVEN("a pool with several workers")
+  {
+    constexpr size_t numThreads{4};
+    gfx::utils::ThreadPool pool{numThreads};
+    std::atomic<size_t> counter{0};
+
+    REQUIRE(pool.size() == numThreads);
+
+    WHEN("submitting many independent tasks")
+    {
+      constexpr size_t numTasks{1000};
+      for (size_t index = 0; index < numTasks; ++index)
+      {
+        pool.submit([&counter] { ++counter; });
+      }
+      pool.wait();
+
+      THEN("every task has run once")
+      {
+        REQUIRE(counter == numTasks);
+      }
+    }
+
+    WHEN("tasks submit nested tasks")
+    {
+      constexpr size_t numOuter{16};
+      constexpr size_t numInner{64};
+      for (size_t outer = 0; outer < numOuter; ++outer)
+      {
+        pool.submit([&pool, &counter] {
+          for (size_t inner = 0; inner < numInner; ++inner)
+          {
+            pool.submit([&counter] { ++counter; });
+          }
+        });
+      }
+      pool.wait();
+
+      THEN("wait covers the nested tasks")
+      {
+        REQUIRE(counter == numOuter * numInner);
+      }
+    }
+  }
+}
@@ -0,0 +1,92 @@
+#include "trace.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <thread>
+
+SCENARIO("Frame events are traced to a binary file", "[gfx][utils][trace]")
+{
+  namespace trace = gfx::utils::trace;
+
+  const auto path = std::filesystem::temp_directory_path() / "gfx_trace_test.bin";
+
+  const trace::EventId decoded = trace::event("decoded");
+  const trace::EventId swapped = trace::event("swap \"main\"");
+
+  GIVEN("a closed trace")
+  {
+    THEN("recording is disabled")
+    {
+      REQUIRE_FALSE(trace::enabled());
+      trace::instant(decoded);
+    }
+
+    THEN("registering a name twice returns the same event")
+    {
+      REQUIRE(trace::event("decoded") == decoded);
+      REQUIRE(decoded != swapped);
+    }
+  }
+
+  GIVEN("events recorded from two threads")
+  {
+    constexpr size_t numFrames{100};
+    trace::open(path);
+    REQUIRE(trace::enabled());
+
+    std::thread decoder{[decoded] {
+      for (size_t frame = 0; frame < numFrames; ++frame)
+      {
+        trace::instant(decoded, frame);
+      }
+    }};
+
+    for (size_t frame = 0; frame < numFrames; ++frame)
+    {
+      const trace::Scope scope{swapped, frame};
+    }
+    decoder.join();
+    trace::close();
+
+    WHEN("converting to chrome trace json")
+    {
+      std::stringstream json{};
+      const size_t numEvents = trace::to_chrome_json(path, json);
+
+      THEN("every event is written")
+      {
+        REQUIRE(numEvents == numFrames * 3);
+        REQUIRE(trace::dropped() == 0);
+        REQUIRE(json.str().find(R"("name":"decoded","ph":"i")") != std::string::npos);
+        REQUIRE(json.str().find(R"("name":"swap \"main\"","ph":"B")")
+                != std::string::npos);
+      }
+    }
+  }
+
+  GIVEN("more events than the trace holds")
+  {
+    constexpr size_t capacity{1024};
+    constexpr size_t numEvents{1500};
+    trace::open(path, capacity);
+
+    for (size_t index = 0; index < numEvents; ++index)
+    {
+      trace::instant(decoded, index);
+    }
+    trace::close();
+
+    THEN("the overflow is dropped and counted")
+    {
+      std::stringstream json{};
+      REQUIRE(trace::to_chrome_json(path, json) == capacity);
+      REQUIRE(trace::dropped() == numEvents - capacity);
+    }
+  }
+
+  std::filesystem::remove(path);
+}
@@ -57,6 +57,140 @@ obj_unit_test(
   INCLUDE_PATH gfx/utils/ gfx/
 )
 
+obj_unit_test(
+  thread_pool
+  DEPENDENCIES utils::thread_pool stubs::utils::logger
+  INCLUDE_PATH gfx/utils/
+)
+
+obj_unit_test(
+  image_sink
+  DEPENDENCIES utils::image_sink utils::thread_pool stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_unit_test(spsc_ring INCLUDE_PATH gfx/utils/)
+
+obj_unit_test(
+  call_site
+  DEPENDENCIES stubs::utils::logger
+  INCLUDE_PATH gfx/utils/
+)
+
+obj_unit_test(
+  trace
+  DEPENDENCIES utils::trace stubs::utils::logger
+  INCLUDE_PATH gfx/utils/
+)
+
+obj_unit_test(
+  profile
+  DEPENDENCIES utils::profile stubs::utils::logger
+  INCLUDE_PATH gfx/utils/
+)
+
+obj_unit_test(
+  converter
+  DEPENDENCIES utils::video_demuxer stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_unit_test(
+  demuxer
+  DEPENDENCIES utils::video_demuxer dummy_video_muxer stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_unit_test(
+  frame_stats
+  DEPENDENCIES graphics::frame_stats
+  INCLUDE_PATH gfx/graphics/
+)
+
+obj_unit_test(
+  streaming_texture
+  DEPENDENCIES graphics::window graphics::components stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_unit_test(
+  quad_batch
+  DEPENDENCIES graphics::window graphics::components stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_unit_test(
+  program_cache
+  DEPENDENCIES graphics::window graphics::components stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_unit_test(
+  shader
+  DEPENDENCIES graphics::window graphics::components stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_unit_test(
+  gpu_profile
+  DEPENDENCIES graphics::window graphics::components stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_unit_test(
+  render_target
+  DEPENDENCIES graphics::window graphics::components stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_unit_test(
+  yuv_converter
+  DEPENDENCIES graphics::window graphics::components stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_unit_test(
+  skyline_packer
+  DEPENDENCIES graphics::window graphics::components stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_unit_test(
+  texture_atlas
+  DEPENDENCIES graphics::window graphics::components stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_unit_test(
+  pixel_format
+  DEPENDENCIES graphics::pixel_format stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_unit_test(
+  texture
+  DEPENDENCIES graphics::window graphics::components stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_unit_test(
+  yuv_texture_shader
+  DEPENDENCIES graphics::window graphics::components stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_unit_test(
+  upload_thread
+  DEPENDENCIES graphics::window graphics::components stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
+obj_unit_test(
+  texture_readback
+  DEPENDENCIES graphics::window graphics::components stubs::utils::logger
+  INCLUDE_PATH gfx/
+)
+
 obj_unit_test(
   pip_output_parser
   DEPENDENCIES google::re2
@@ -0,0 +1,158 @@
+#include "graphics/fence.hpp"
+#include "graphics/shader.hpp"
+#include "graphics/texture.hpp"
+#include "graphics/upload_thread.hpp"
+#include "graphics/window.hpp"
+#include "shaders/texture.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <GL/glew.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Needs an OpenGL context, hidden from the default run, see streaming_texture_test
+SCENARIO("Uploads on a worker with a shared context",
+         "[gfx][graphics][upload_thread][.gl]")
+{
+  const gfx::graphics::Window window{"upload_thread_test",
+                                     gfx::Size{1, 1},
+                                     gfx::graphics::Window::Mode::Offscreen};
+
+  GIVEN("an upload thread and a texture created on the render thread")
+  {
+    constexpr gfx::Size size{8, 8};
+    const gfx::graphics::Texture texture{size};
+    const std::vector<uint8_t> red = [] {
+      std::vector<uint8_t> pixels{};
+      for (size_t index = 0; index < 64; ++index)
+      {
+        pixels.insert(pixels.end(), {0xFF, 0, 0, 0xFF});
+      }
+      return pixels;
+    }();
+
+    gfx::graphics::UploadThread uploads{window};
+
+    WHEN("the worker uploads into it")
+    {
+      const std::thread::id renderThread = std::this_thread::get_id();
+      std::thread::id uploadThread{};
+
+      auto uploaded = uploads.submit([&] {
+        uploadThread = std::this_thread::get_id();
+        texture.upload(red.data());
+      });
+
+      const gfx::graphics::Fence fence = uploaded.get();
+      fence.wait();
+
+      THEN("the render thread sees the texels after the fence")
+      {
+        REQUIRE(uploadThread != renderThread);
+        REQUIRE(fence.clientWait(std::chrono::seconds{1}));
+        REQUIRE(fence.signaled());
+
+        std::vector<uint8_t> texels(red.size());
+        texture.bind();
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+        REQUIRE(texels == red);
+      }
+    }
+
+    WHEN("the render thread uploads into it before a job reads it")
+    {
+      texture.upload(red.data());
+
+      std::vector<uint8_t> texels(red.size());
+      uploads
+          .submit([&] {
+            texture.bind();
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+          })
+          .get();
+
+      THEN("the job sees the texels")
+      {
+        REQUIRE(texels == red);
+      }
+    }
+
+    WHEN("a program is compiled on the worker")
+    {
+      std::unique_ptr<gfx::graphics::Shader> shader{};
+      uploads.submit([&] {
+               shader = std::make_unique<gfx::graphics::Shader>(
+                   gfx::graphics::shaders::Texture::vertex,
+                   gfx::graphics::shaders::Texture::fragment);
+             })
+          .get()
+          .wait();
+
+      THEN("the render thread can use it")
+      {
+        while (glGetError() != GL_NO_ERROR)
+        {
+        }
+        shader->use();
+        REQUIRE(glGetError() == GL_NO_ERROR);
+        REQUIRE(shader->location("uMatrix") != -1);
+      }
+    }
+
+    WHEN("a job throws")
+    {
+      auto failed = uploads.submit([] { throw std::runtime_error{"upload"}; });
+
+      THEN("the exception comes out of the future and later jobs still run")
+      {
+        REQUIRE_THROWS_AS(failed.get(), std::runtime_error);
+
+        bool ran{false};
+        (void)uploads.submit([&] { ran = true; });
+        uploads.wait();
+        REQUIRE(ran);
+        REQUIRE(uploads.pending() == 0);
+      }
+    }
+  }
+}
+
+// Needs a display server, the GLFW path of SharedContext
+SCENARIO("Uploads on a worker with a shared GLFW context",
+         "[gfx][graphics][upload_thread][.gl]")
+{
+  const gfx::graphics::Window window{"upload_thread_test",
+                                     gfx::Size{1, 1},
+                                     gfx::graphics::Window::Mode::Headless};
+
+  GIVEN("an upload thread on a hidden window")
+  {
+    constexpr gfx::Size size{2, 2};
+    const gfx::graphics::Texture texture{size};
+    const std::vector<uint8_t> green{0, 0xFF, 0, 0xFF, 0, 0xFF, 0, 0xFF,
+                                     0, 0xFF, 0, 0xFF, 0, 0xFF, 0, 0xFF};
+
+    gfx::graphics::UploadThread uploads{window};
+
+    WHEN("the worker uploads into a texture of the window")
+    {
+      uploads.submit([&] { texture.upload(green.data()); }).get().wait();
+
+      THEN("the render thread sees the texels")
+      {
+        std::vector<uint8_t> texels(green.size());
+        texture.bind();
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+        REQUIRE(texels == green);
+      }
+    }
+  }
+}
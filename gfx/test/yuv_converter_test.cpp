@@ -0,0 +1,154 @@
+#include "graphics/texture.hpp"
+#include "graphics/window.hpp"
+#include "graphics/yuv_converter.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace
+{
+using gfx::graphics::YuvConverter;
+
+constexpr size_t width{16};
+constexpr size_t height{4};
+
+// Top half red on the left and white on the right, bottom half black
+std::vector<uint8_t> test_pattern()
+{
+  std::vector<uint8_t> pixels(width * height * 4, 0);
+  for (size_t y = 0; y < height / 2; ++y)
+  {
+    for (size_t x = 0; x < width; ++x)
+    {
+      uint8_t* pixel = &pixels[(y * width + x) * 4];
+      pixel[0]       = 0xFF;                     // NOLINT
+      pixel[1]       = x < width / 2 ? 0 : 0xFF; // NOLINT
+      pixel[2]       = x < width / 2 ? 0 : 0xFF; // NOLINT
+      pixel[3]       = 0xFF;                     // NOLINT
+    }
+  }
+  return pixels;
+}
+
+std::vector<uint8_t> convert(const YuvConverter& converter,
+                             const gfx::graphics::Texture& texture,
+                             bool flip = false)
+{
+  std::vector<uint8_t> frame(converter.frameSize(), 0);
+  converter.convert(texture.get(), flip);
+  converter.read(frame);
+  return frame;
+}
+
+std::vector<uint8_t> repeat(std::initializer_list<uint8_t> values, size_t count)
+{
+  std::vector<uint8_t> result{};
+  for (size_t index = 0; index < count; ++index)
+  {
+    result.insert(result.end(), values);
+  }
+  return result;
+}
+
+std::vector<uint8_t> row(const std::vector<uint8_t>& frame,
+                         const YuvConverter::Plane& plane,
+                         size_t index)
+{
+  const auto begin = frame.begin() + static_cast<ptrdiff_t>(plane.offset
+                                                            + index * plane.stride);
+  return {begin, begin + static_cast<ptrdiff_t>(plane.stride)};
+}
+
+std::vector<uint8_t> concat(std::vector<uint8_t> lhs, const std::vector<uint8_t>& rhs)
+{
+  lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+  return lhs;
+}
+} // namespace
+
+// Needs an OpenGL context, hidden from the default run, see streaming_texture_test
+SCENARIO("RGB to 4:2:0 YUV on the GPU", "[gfx][graphics][yuv_converter][.gl]")
+{
+  const gfx::graphics::Window window{"yuv_converter_test",
+                                     gfx::Size{width, height},
+                                     gfx::graphics::Window::Mode::Headless};
+
+  std::vector<uint8_t> pixels = test_pattern();
+  const gfx::graphics::Texture texture{gfx::Size{width, height}, pixels.data()};
+
+  GIVEN("an I420 converter with the BT.709 limited range defaults")
+  {
+    const YuvConverter converter{gfx::Size{width, height}};
+
+    THEN("the planes are laid out as AV_PIX_FMT_YUV420P")
+    {
+      REQUIRE(converter.frameSize() == width * height * 3 / 2);
+      REQUIRE(converter.planes().size() == 3);
+      REQUIRE(converter.planes()[1].offset == width * height);
+      REQUIRE(converter.planes()[2].offset == width * height * 5 / 4);
+      REQUIRE(converter.planes()[2].stride == width / 2);
+    }
+
+    WHEN("a frame is converted")
+    {
+      const std::vector<uint8_t> frame = convert(converter, texture);
+      const auto planes                = converter.planes();
+
+      THEN("luma and chroma match the reference code values")
+      {
+        REQUIRE(row(frame, planes[0], 0) == concat(repeat({63}, 8), repeat({235}, 8)));
+        REQUIRE(row(frame, planes[0], 3) == repeat({16}, width));
+        REQUIRE(row(frame, planes[1], 0) == concat(repeat({102}, 4), repeat({128}, 4)));
+        REQUIRE(row(frame, planes[2], 0) == concat(repeat({240}, 4), repeat({128}, 4)));
+        REQUIRE(row(frame, planes[2], 1) == repeat({128}, width / 2));
+      }
+    }
+
+    WHEN("a rendered frame is converted bottom up")
+    {
+      const std::vector<uint8_t> frame = convert(converter, texture, true);
+
+      THEN("the black half is on top")
+      {
+        REQUIRE(row(frame, converter.planes()[0], 0) == repeat({16}, width));
+        REQUIRE(row(frame, converter.planes()[0], 3)[0] == 63);
+      }
+    }
+  }
+
+  GIVEN("an NV12 converter")
+  {
+    const YuvConverter converter{gfx::Size{width, height}, YuvConverter::Layout::NV12};
+    const std::vector<uint8_t> frame = convert(converter, texture);
+
+    THEN("chroma is interleaved in one plane")
+    {
+      REQUIRE(converter.planes().size() == 2);
+      REQUIRE(row(frame, converter.planes()[1], 0)
+              == concat(repeat({102, 240}, 4), repeat({128, 128}, 4)));
+    }
+  }
+
+  GIVEN("a BT.601 full range converter")
+  {
+    const YuvConverter converter{gfx::Size{width, height},
+                                 YuvConverter::Layout::I420,
+                                 YuvConverter::Matrix::BT601,
+                                 YuvConverter::Range::Full};
+    const std::vector<uint8_t> frame = convert(converter, texture);
+    const auto planes                = converter.planes();
+
+    THEN("red and black use the JPEG code values, Cr saturates")
+    {
+      REQUIRE(frame[planes[0].offset] == 76);
+      REQUIRE(frame[planes[0].offset + 3 * width] == 0);
+      REQUIRE(frame[planes[1].offset] == 85);
+      REQUIRE(frame[planes[2].offset] == 255);
+    }
+  }
+}
@@ -0,0 +1,105 @@
+#include "graphics/pixel_format.hpp"
+#include "graphics/planar_texture.hpp"
+#include "graphics/quad.hpp"
+#include "graphics/render_target.hpp"
+#include "graphics/texture.hpp"
+#include "graphics/window.hpp"
+#include "graphics/yuv_converter.hpp"
+#include "graphics/yuv_texture_shader.hpp"
+#include "vocabulary/size.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+using gfx::graphics::PixelFormat;
+using gfx::graphics::YuvConverter;
+
+constexpr gfx::Size size{16, 4};
+constexpr std::array<uint8_t, 4> orange{200, 96, 32, 0xFF};
+
+// Encodes a flat orange frame with YuvConverter and draws it back through the
+// planes, the largest difference to the original in any channel
+int round_trip(PixelFormat format,
+               YuvConverter::Matrix matrix,
+               YuvConverter::Range range)
+{
+  std::vector<uint8_t> pixels{};
+  for (size_t index = 0; index < size.size(); ++index)
+  {
+    pixels.insert(pixels.end(), orange.begin(), orange.end());
+  }
+  const gfx::graphics::Texture input{size, pixels.data()};
+
+  const auto layout = format == PixelFormat::NV12 ? YuvConverter::Layout::NV12
+                                                  : YuvConverter::Layout::I420;
+  const YuvConverter converter{size, layout, matrix, range};
+  std::vector<uint8_t> encoded(converter.frameSize());
+  converter.convert(input.get());
+  converter.read(encoded);
+
+  const gfx::graphics::PlanarTexture frame{size, format};
+  frame.upload(encoded);
+
+  const gfx::graphics::RenderTarget target{size, 1, false};
+  target.bind();
+
+  const gfx::graphics::YuvTextureShader shader{format, matrix, range};
+  shader.bind(frame);
+  shader.setMatrixUniform(1.0F);
+  gfx::graphics::Quad{}.draw();
+
+  std::vector<uint8_t> decoded(size.size() * 4);
+  target.read(decoded);
+
+  int difference{0};
+  for (size_t index = 0; index < decoded.size(); ++index)
+  {
+    difference = std::max(difference, std::abs(decoded[index] - pixels[index]));
+  }
+  return difference;
+}
+} // namespace
+
+// Needs an OpenGL context, hidden from the default run, see streaming_texture_test
+SCENARIO("YUV planes converted while sampling",
+         "[gfx][graphics][yuv_texture_shader][.gl]")
+{
+  const gfx::graphics::Window window{"yuv_texture_shader_test",
+                                     gfx::Size{1, 1},
+                                     gfx::graphics::Window::Mode::Offscreen};
+
+  GIVEN("frames encoded by YuvConverter")
+  {
+    THEN("I420 in BT.709 limited range decodes to the original colour")
+    {
+      REQUIRE(round_trip(PixelFormat::I420,
+                         YuvConverter::Matrix::BT709,
+                         YuvConverter::Range::Limited)
+              <= 2);
+    }
+
+    THEN("NV12 does too")
+    {
+      REQUIRE(round_trip(PixelFormat::NV12,
+                         YuvConverter::Matrix::BT709,
+                         YuvConverter::Range::Limited)
+              <= 2);
+    }
+
+    THEN("so does BT.601 full range")
+    {
+      REQUIRE(round_trip(PixelFormat::I420,
+                         YuvConverter::Matrix::BT601,
+                         YuvConverter::Range::Full)
+              <= 2);
+    }
+  }
+}
@@ -108,6 +108,22 @@ void ArgParser::_checkForFrameRate()
   }
 }
 
+void ArgParser::_checkForShmemName()
+{
+  if (_vm.count("shmem-name") != 0)
+  {
+    TRYCATCH(_shmemName = _vm["shmem-name"].as<std::string>())
+  }
+}
+
+void ArgParser::_checkForTracePath()
+{
+  if (_vm.count("trace") != 0)
+  {
+    TRYCATCH(_tracePath = _vm["trace"].as<std::filesystem::path>())
+  }
+}
+
 void ArgParser::_checkForVerbose()
 {
   if (_vm.count("verbose") != 0)
@@ -141,6 +157,14 @@ ArgParser::ArgParser(int argc, const char* const* argv)
 
   desc.add_options()("frame-rate", po::value<uint32_t>(), "as fps/herz");
 
+  desc.add_options()("shmem-name",
+                     po::value<std::string>(),
+                     "Name of shared memory channel, e.g. /gfx_video");
+
+  desc.add_options()("trace",
+                     po::value<std::filesystem::path>(),
+                     "Write a frame event trace, convert it with trace-to-json");
+
   desc.add_options()("verbose", po::bool_switch(), "enable more logging");
 
   po::store(po::parse_command_line(argc, argv, desc), _vm);
@@ -159,6 +183,8 @@ ArgParser::ArgParser(int argc, const char* const* argv)
   _checkForInputUri();
   _checkForDuration();
   _checkForFrameRate();
+  _checkForShmemName();
+  _checkForTracePath();
   _checkForVerbose();
 }
 
@@ -225,6 +251,20 @@ gfx::time::fps ArgParser::getFrameRate() const
   throw std::invalid_argument{"gfx::missing '--frame-rate' argument value"};
 }
 
+std::string ArgParser::getShmemName() const
+{
+  if (_shmemName.has_value())
+  {
+    return _shmemName.value();
+  }
+  throw std::invalid_argument{"gfx::missing '--shmem-name' argument value"};
+}
+
+std::optional<std::filesystem::path> ArgParser::getTracePath() const
+{
+  return _tracePath;
+}
+
 bool ArgParser::getVerbose() const
 {
   return _verbose;
@@ -8,6 +8,7 @@
 
 #include <filesystem>
 #include <optional>
+#include <string>
 
 namespace gfx::utils
 {
@@ -21,6 +22,8 @@ class ArgParser
     std::optional<gfx::URI> _inputUri{};
     std::optional<gfx::time::sec> _duration{};
     std::optional<gfx::time::fps> _frameRate{};
+    std::optional<std::string> _shmemName{};
+    std::optional<std::filesystem::path> _tracePath{};
     bool _verbose{false};
 
     boost::program_options::variables_map _vm{};
@@ -32,6 +35,8 @@ class ArgParser
     void _checkForInputUri();
     void _checkForDuration();
     void _checkForFrameRate();
+    void _checkForShmemName();
+    void _checkForTracePath();
     void _checkForVerbose();
 
   public:
@@ -44,6 +49,10 @@ class ArgParser
     [[nodiscard]] gfx::URI getInputUri() const;
     [[nodiscard]] gfx::time::sec getDuration() const;
     [[nodiscard]] gfx::time::fps getFrameRate() const;
+    [[nodiscard]] std::string getShmemName() const;
     [[nodiscard]] bool getVerbose() const;
+
+    // Empty unless '--trace' is given, tracing is optional in every application
+    [[nodiscard]] std::optional<std::filesystem::path> getTracePath() const;
 };
 } // namespace gfx::utils
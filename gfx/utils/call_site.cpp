@@ -0,0 +1,68 @@
+#include "logger.hpp"
+
+#include <time.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace gfx::utils::logger
+{
+namespace
+{
+// Coarse clock, a few nanoseconds to read and precise enough for per second budgets
+uint32_t now_seconds()
+{
+  timespec now{};
+  clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+  return static_cast<uint32_t>(now.tv_sec);
+}
+} // namespace
+
+bool RateLimit::acquire(uint64_t& suppressed)
+{
+  return acquire(suppressed, now_seconds());
+}
+
+bool RateLimit::acquire(uint64_t& suppressed, uint32_t second)
+{
+  constexpr uint64_t countMask{0xFFFF'FFFF};
+
+  uint64_t window = _window.load(std::memory_order_relaxed);
+  uint64_t next{};
+  do
+  {
+    const uint64_t count = (window >> 32U) == second ? (window & countMask) : 0;
+    if (count >= _perSecond)
+    {
+      _suppressed.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    next = (uint64_t{second} << 32U) | (count + 1);
+  } while (!_window.compare_exchange_weak(window, next, std::memory_order_relaxed));
+
+  suppressed = _suppressed.exchange(0, std::memory_order_relaxed);
+  return true;
+}
+
+Deduplicate::Decision Deduplicate::check(uint64_t hash)
+{
+  const uint32_t second = now_seconds();
+
+  if (_hash.exchange(hash, std::memory_order_relaxed) != hash)
+  {
+    _reported.store(second, std::memory_order_relaxed);
+    return {.write = true, .repeats = _repeats.exchange(0, std::memory_order_relaxed)};
+  }
+
+  _repeats.fetch_add(1, std::memory_order_relaxed);
+
+  // Still repeating, report the count once a second so it is not lost
+  uint32_t reported = _reported.load(std::memory_order_relaxed);
+  if (reported != second
+      && _reported.compare_exchange_strong(reported, second, std::memory_order_relaxed))
+  {
+    return {.write = false, .repeats = _repeats.exchange(0, std::memory_order_relaxed)};
+  }
+  return {.write = false, .repeats = 0};
+}
+} // namespace gfx::utils::logger
@@ -0,0 +1,180 @@
+#include "converter.hpp"
+
+#include "vocabulary/size.hpp"
+
+#include <fmt/core.h>
+
+extern "C"
+{
+#include <libavutil/buffer.h>
+#include <libavutil/error.h>
+#include <libavutil/frame.h>
+#include <libavutil/imgutils.h>
+#include <libavutil/opt.h>
+#include <libavutil/pixfmt.h>
+#include <libavutil/timestamp.h>
+#include <libswscale/swscale.h>
+}
+
+#include "utils/libav_string_fix.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+namespace gfx::utils::video
+{
+namespace
+{
+// The destination frame only borrows caller memory
+void borrow_buffer(void* /*opaque*/, uint8_t* /*data*/) {}
+
+void set_option(SwsContext* context, const char* name, int64_t value)
+{
+  const int ret = av_opt_set_int(context, name, value, 0);
+  if (ret < 0)
+  {
+    throw std::runtime_error(fmt::format("gfx::Converter - could not set '{}' ({})",
+                                         name,
+                                         av_err2str(ret)));
+  }
+}
+} // namespace
+
+Converter::Converter(int threads)
+    : _threads{threads},
+      _destination{av_frame_alloc()}
+{
+  if (_destination == nullptr)
+  {
+    throw std::runtime_error("gfx::Converter - could not allocate frame");
+  }
+}
+
+Converter::~Converter()
+{
+  sws_freeContext(_context);
+  av_frame_free(&_destination);
+}
+
+size_t Converter::bufferSize(const gfx::Size& size, int format)
+{
+  const int ret = av_image_get_buffer_size(static_cast<AVPixelFormat>(format),
+                                           size.width,
+                                           size.height,
+                                           1);
+  if (ret < 0)
+  {
+    throw std::runtime_error(
+        fmt::format("gfx::Converter - invalid image size ({})", av_err2str(ret)));
+  }
+  return static_cast<size_t>(ret);
+}
+
+int Converter::toPixelFormat(OutputFormat format, int nativeFormat)
+{
+  switch (format)
+  {
+    case OutputFormat::RGBA:
+      return AV_PIX_FMT_RGBA;
+    case OutputFormat::NV12:
+      return AV_PIX_FMT_NV12;
+    case OutputFormat::Native:
+      break;
+  }
+  return nativeFormat;
+}
+
+// NOLINTNEXTLINE(readability-function-size)
+void Converter::_configure(const Parameters& parameters)
+{
+  if (_context != nullptr && parameters == _parameters)
+  {
+    return;
+  }
+
+  sws_freeContext(_context);
+  _context    = nullptr;
+  _parameters = Parameters{};
+
+  SwsContext* context = sws_alloc_context();
+  if (context == nullptr)
+  {
+    throw std::runtime_error("gfx::Converter - could not allocate scaling context");
+  }
+  _context = context;
+
+  set_option(context, "srcw", parameters.srcWidth);
+  set_option(context, "srch", parameters.srcHeight);
+  set_option(context, "src_format", parameters.srcFormat);
+  set_option(context, "dstw", parameters.dstWidth);
+  set_option(context, "dsth", parameters.dstHeight);
+  set_option(context, "dst_format", parameters.dstFormat);
+  set_option(context, "sws_flags", SWS_BILINEAR);
+  set_option(context, "threads", _threads);
+
+  const int ret = sws_init_context(context, nullptr, nullptr);
+  if (ret < 0)
+  {
+    throw std::runtime_error(fmt::format(
+        "gfx::Converter - could not initialize scaling context ({})",
+        av_err2str(ret)));
+  }
+
+  _parameters = parameters;
+}
+
+// NOLINTNEXTLINE(readability-function-size)
+void Converter::convert(const AVFrame* source,
+                        std::span<uint8_t> destination,
+                        const gfx::Size& size,
+                        int format)
+{
+  if (destination.size() < bufferSize(size, format))
+  {
+    throw std::invalid_argument("gfx::Converter - destination buffer too small");
+  }
+
+  _configure(Parameters{
+      .srcWidth  = source->width,
+      .srcHeight = source->height,
+      .srcFormat = source->format,
+      .dstWidth  = size.width,
+      .dstHeight = size.height,
+      .dstFormat = format,
+  });
+
+  // sws_scale_frame allocates its own output unless the frame holds a buffer
+  _destination->buf[0] = av_buffer_create(destination.data(),
+                                          destination.size(),
+                                          borrow_buffer,
+                                          nullptr,
+                                          0);
+  if (_destination->buf[0] == nullptr)
+  {
+    throw std::runtime_error("gfx::Converter - could not wrap destination buffer");
+  }
+
+  _destination->width  = size.width;
+  _destination->height = size.height;
+  _destination->format = format;
+
+  av_image_fill_arrays(static_cast<uint8_t**>(_destination->data),
+                       static_cast<int*>(_destination->linesize),
+                       destination.data(),
+                       static_cast<AVPixelFormat>(format),
+                       size.width,
+                       size.height,
+                       1);
+
+  const int ret = sws_scale_frame(_context, _destination, source);
+  av_frame_unref(_destination);
+
+  if (ret < 0)
+  {
+    throw std::runtime_error(
+        fmt::format("gfx::Converter - conversion failed ({})", av_err2str(ret)));
+  }
+}
+} // namespace gfx::utils::video
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "vocabulary/size.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+struct AVFrame;
+struct SwsContext;
+
+namespace gfx::utils::video
+{
+enum class OutputFormat
+{
+  Native,
+  RGBA,
+  NV12
+};
+
+// Converted frames are written packed, planes back to back, into caller memory.
+// The scaling context is kept until source or destination parameters change.
+class Converter
+{
+  public:
+    // 'threads' is the number of slice threads, 0 picks one per core
+    explicit Converter(int threads = 0);
+    ~Converter();
+
+    Converter(const Converter&)            = delete;
+    Converter& operator=(const Converter&) = delete;
+    Converter(Converter&&)                 = delete;
+    Converter& operator=(Converter&&)      = delete;
+
+    void convert(const AVFrame* source,
+                 std::span<uint8_t> destination,
+                 const gfx::Size& size,
+                 int format);
+
+    [[nodiscard]] static size_t bufferSize(const gfx::Size& size, int format);
+    [[nodiscard]] static int toPixelFormat(OutputFormat format, int nativeFormat);
+
+  private:
+    struct Parameters
+    {
+        int srcWidth{};
+        int srcHeight{};
+        int srcFormat{-1};
+        int dstWidth{};
+        int dstHeight{};
+        int dstFormat{-1};
+
+        bool operator==(const Parameters&) const = default;
+    };
+
+    int _threads{};
+    Parameters _parameters{};
+    SwsContext* _context{nullptr};
+    AVFrame* _destination{nullptr};
+
+    void _configure(const Parameters& parameters);
+};
+} // namespace gfx::utils::video
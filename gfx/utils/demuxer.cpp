@@ -12,6 +12,15 @@
  * all copies or substantial portions of the Software.
  */
 
+#include "demuxer.hpp"
+
+#include "utils/logger.hpp"
+#include "utils/profile.hpp"
+#include "utils/trace.hpp"
+#include "vocabulary/size.hpp"
+#include "vocabulary/time.hpp"
+#include "vocabulary/uri.hpp"
+
 #include <fmt/core.h>
 
 extern "C"
@@ -24,381 +33,575 @@ extern "C"
 #include <libavutil/error.h>
 #include <libavutil/frame.h>
 #include <libavutil/imgutils.h>
-#include <libavutil/mem.h>
+#include <libavutil/mathematics.h>
 #include <libavutil/pixdesc.h>
 #include <libavutil/pixfmt.h>
+#include <libavutil/rational.h>
 #include <libavutil/timestamp.h>
 }
 
-#include "libav_string_fix.hpp"
+#include "utils/libav_string_fix.hpp"
 
+#include <algorithm>
 #include <cerrno>
+#include <cmath>
 #include <cstdint>
-#include <cstdio>
-#include <cstdlib>
+#include <exception>
 #include <iterator>
 #include <memory>
 #include <optional>
 #include <span>
+#include <stdexcept>
+#include <utility>
 
-namespace gfx
+namespace gfx::utils::video
+{
+namespace
 {
-// NOLINTBEGIN
-static AVFormatContext* g_fmt_ctx{nullptr};
-static AVCodecContext* g_video_dec_ctx{nullptr};
+constexpr int stopRequested{1};
+constexpr AVRational milliseconds{1, 1000};
 
-static int g_width{};
-static int g_height{};
+// Only keyframes are decoded in sparse mode, thumbnails do not need the loop filter
+class DiscardGuard
+{
+  public:
+    explicit DiscardGuard(AVCodecContext* context)
+        : _context{context},
+          _skipFrame{context->skip_frame},
+          _skipLoopFilter{context->skip_loop_filter}
+    {
+      _context->skip_frame       = AVDISCARD_NONKEY;
+      _context->skip_loop_filter = AVDISCARD_ALL;
+    }
 
-static AVPixelFormat g_pix_fmt{};
+    ~DiscardGuard()
+    {
+      _context->skip_frame       = _skipFrame;
+      _context->skip_loop_filter = _skipLoopFilter;
+    }
 
-static AVStream* g_video_stream{nullptr};
+    DiscardGuard(const DiscardGuard&)            = delete;
+    DiscardGuard& operator=(const DiscardGuard&) = delete;
+    DiscardGuard(DiscardGuard&&)                 = delete;
+    DiscardGuard& operator=(DiscardGuard&&)      = delete;
 
-static const char* g_src_filename{nullptr};
-static const char* g_video_dst_filename{nullptr};
+  private:
+    AVCodecContext* _context;
+    AVDiscard _skipFrame;
+    AVDiscard _skipLoopFilter;
+};
 
-static void close_file(FILE* filePtr)
+// Releases a frame or packet on every way out, the converter and the callback may
+// throw
+template <typename Data, void (*unref)(Data*)>
+class UnrefGuard
 {
-  fclose(filePtr);
-}
+  public:
+    explicit UnrefGuard(Data* data)
+        : _data{data}
+    {}
 
-using UniqueFile = std::unique_ptr<FILE, decltype(&close_file)>;
-
-static UniqueFile makeUniqueFile(const char* filename, const char* mode)
-{
-  return UniqueFile(fopen(filename, mode), &close_file);
-}
+    ~UnrefGuard()
+    {
+      unref(_data);
+    }
 
-// TODO clang-diagnostic-exit-time-destructors
-// TODO clang-diagnostic-global-constructors
-static std::optional<UniqueFile> g_video_dst_file{std::nullopt};
+    UnrefGuard(const UnrefGuard&)            = delete;
+    UnrefGuard& operator=(const UnrefGuard&) = delete;
+    UnrefGuard(UnrefGuard&&)                 = delete;
+    UnrefGuard& operator=(UnrefGuard&&)      = delete;
 
-static uint8_t* g_video_dst_data[4] = {nullptr};
-static int g_video_dst_linesize[4];
-static size_t g_video_dst_bufsize;
+  private:
+    Data* _data;
+};
 
-static int g_video_stream_idx = -1;
-static AVFrame* g_frame{nullptr};
-static AVPacket* g_pkt{nullptr};
-static int g_video_frame_count = 0;
+using FrameUnref  = UnrefGuard<AVFrame, av_frame_unref>;
+using PacketUnref = UnrefGuard<AVPacket, av_packet_unref>;
 
-// NOLINTEND
-namespace
-{
-int output_video_frame(AVFrame* frame)
+// NOLINTNEXTLINE(readability-function-size)
+AVCodecContext* open_codec_context(AVFormatContext* fmt_ctx,
+                                   int* stream_idx,
+                                   int threads)
 {
-  if (frame->width != g_width || frame->height != g_height
-      || frame->format != g_pix_fmt)
+  const int ret = av_find_best_stream(fmt_ctx, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+  if (ret < 0)
   {
-    fmt::print(stderr,
-               "Error: Width, height and pixel format have to be "
-               "constant in a rawvideo file, but the width, height or "
-               "pixel format of the input video changed:\n"
-               "old: width = %d, height = %d, format = %s\n"
-               "new: width = %d, height = %d, format = %s\n",
-               g_width,
-               g_height,
-               av_get_pix_fmt_name(g_pix_fmt),
-               frame->width,
-               frame->height,
-               av_get_pix_fmt_name(static_cast<AVPixelFormat>(frame->format)));
-    return -1;
+    throw std::runtime_error(
+        fmt::format("gfx::Demuxer - could not find video stream ({})",
+                    av_err2str(ret)));
   }
 
-  fmt::print("video_frame n:%d\n", g_video_frame_count++);
-
-  av_image_copy(static_cast<uint8_t**>(g_video_dst_data),
-                static_cast<int*>(g_video_dst_linesize),
-                const_cast<const uint8_t**>(frame->data), // NOLINT
-                static_cast<int*>(frame->linesize),
-                g_pix_fmt,
-                g_width,
-                g_height);
+  const int stream_index = ret;
+  AVStream* stream       = *std::next(fmt_ctx->streams, stream_index);
 
-  // NOLINTNEXTLINE
-  fwrite(g_video_dst_data[0], 1, g_video_dst_bufsize, g_video_dst_file.value().get());
-  return 0;
-}
+  const AVCodec* dec = avcodec_find_decoder(stream->codecpar->codec_id);
+  if (dec == nullptr)
+  {
+    throw std::runtime_error("gfx::Demuxer - failed to find video codec");
+  }
 
-// NOLINTNEXTLINE(readability-function-cognitive-complexity,readability-function-size)
-int decode_packet(AVCodecContext* dec, const AVPacket* pkt)
-{
-  int ret = 0;
+  AVCodecContext* dec_ctx = avcodec_alloc_context3(dec);
+  if (dec_ctx == nullptr)
+  {
+    throw std::runtime_error("gfx::Demuxer - failed to allocate video codec context");
+  }
 
-  ret = avcodec_send_packet(dec, pkt);
-  if (ret < 0)
+  if (avcodec_parameters_to_context(dec_ctx, stream->codecpar) < 0)
   {
-    fmt::print(stderr,
-               "Error submitting a packet for decoding (%s)\n",
-               av_err2str(ret));
-    return ret;
+    avcodec_free_context(&dec_ctx);
+    throw std::runtime_error("gfx::Demuxer - failed to copy video codec parameters");
   }
 
-  while (ret >= 0)
+  dec_ctx->thread_count = threads;
+
+  if (avcodec_open2(dec_ctx, dec, nullptr) < 0)
   {
-    ret = avcodec_receive_frame(dec, g_frame);
-    if (ret < 0)
-    {
-      if (ret == AVERROR_EOF || ret == AVERROR(EAGAIN))
-      {
-        return 0;
-      }
+    avcodec_free_context(&dec_ctx);
+    throw std::runtime_error("gfx::Demuxer - failed to open video codec");
+  }
 
-      fmt::print(stderr, "Error during decoding (%s)\n", av_err2str(ret));
-      return ret;
-    }
+  *stream_idx = stream_index;
 
-    if (dec->codec->type == AVMEDIA_TYPE_VIDEO)
-    {
-      ret = output_video_frame(g_frame);
-    }
+  return dec_ctx;
+}
+} // namespace
 
-    av_frame_unref(g_frame);
-    if (ret < 0)
-    {
-      return ret;
-    }
+Demuxer::Demuxer(const gfx::URI& uri, int threads)
+    : _uri{uri},
+      _threads{threads}
+{
+  try
+  {
+    _open();
   }
+  catch (const std::exception&)
+  {
+    _release();
+    throw;
+  }
+}
 
-  return 0;
+Demuxer::~Demuxer()
+{
+  _release();
 }
 
 // NOLINTNEXTLINE(readability-function-size)
-int open_codec_context(int* stream_idx,
-                       AVCodecContext** dec_ctx,
-                       AVFormatContext* fmt_ctx,
-                       AVMediaType type)
+void Demuxer::_open()
 {
-  int ret          = 0;
-  int stream_index = 0;
-  AVStream* stream{nullptr};
-  const AVCodec* dec{nullptr};
+  if (avformat_open_input(&_formatContext, _uri.c_str(), nullptr, nullptr) < 0)
+  {
+    throw std::runtime_error(
+        fmt::format("gfx::Demuxer - could not open source '{}'", _uri.c_str()));
+  }
 
-  ret = av_find_best_stream(fmt_ctx, type, -1, -1, nullptr, 0);
-  if (ret < 0)
+  if (avformat_find_stream_info(_formatContext, nullptr) < 0)
   {
-    fmt::print(stderr,
-               "Could not find %s stream in input file '%s'\n",
-               av_get_media_type_string(type),
-               g_src_filename);
-    return ret;
+    throw std::runtime_error("gfx::Demuxer - could not find stream information");
   }
 
-  stream_index = ret;
-  stream       = *std::next(fmt_ctx->streams, stream_index);
+  _decoderContext = open_codec_context(_formatContext, &_streamIndex, _threads);
 
-  dec = avcodec_find_decoder(stream->codecpar->codec_id);
-  if (dec == nullptr)
+  _width       = _decoderContext->width;
+  _height      = _decoderContext->height;
+  _pixelFormat = _decoderContext->pix_fmt;
+
+  _reserveBuffer();
+
+  _frame = av_frame_alloc();
+  if (_frame == nullptr)
   {
-    fmt::print(stderr, "Failed to find %s codec\n", av_get_media_type_string(type));
-    return AVERROR(EINVAL);
+    throw std::runtime_error("gfx::Demuxer - could not allocate frame");
   }
 
-  *dec_ctx = avcodec_alloc_context3(dec);
-  if (*dec_ctx == nullptr)
+  _packet = av_packet_alloc();
+  if (_packet == nullptr)
   {
-    fmt::print(stderr,
-               "Failed to allocate the %s codec context\n",
-               av_get_media_type_string(type));
-    return AVERROR(ENOMEM);
+    throw std::runtime_error("gfx::Demuxer - could not allocate packet");
   }
+}
 
-  ret = avcodec_parameters_to_context(*dec_ctx, stream->codecpar);
-  if (ret < 0)
+void Demuxer::_release()
+{
+  avcodec_free_context(&_decoderContext);
+  avformat_close_input(&_formatContext);
+
+  av_packet_free(&_packet);
+  av_frame_free(&_frame);
+}
+
+gfx::Size Demuxer::size() const
+{
+  return gfx::Size{_width, _height};
+}
+
+int Demuxer::pixelFormat() const
+{
+  return _pixelFormat;
+}
+
+const char* Demuxer::pixelFormatName() const
+{
+  return av_get_pix_fmt_name(static_cast<AVPixelFormat>(_pixelFormat));
+}
+
+gfx::time::fps Demuxer::frameRate() const
+{
+  constexpr gfx::time::fps fallback{30};
+  const AVStream* stream = *std::next(_formatContext->streams, _streamIndex);
+
+  const AVRational rate = stream->avg_frame_rate.num != 0 ? stream->avg_frame_rate
+                                                          : stream->r_frame_rate;
+
+  const double framesPerSecond = rate.den != 0 ? av_q2d(rate) : 0.0;
+
+  if (framesPerSecond < 1.0)
   {
-    fmt::print(stderr,
-               "Failed to copy %s codec parameters to decoder context\n",
-               av_get_media_type_string(type));
-    return ret;
+    return fallback;
   }
+  return static_cast<gfx::time::fps>(std::lround(framesPerSecond));
+}
 
-  ret = avcodec_open2(*dec_ctx, dec, nullptr);
-  if (ret < 0)
+gfx::Size Demuxer::outputSize() const
+{
+  return _outputSize.value_or(size());
+}
+
+int Demuxer::outputPixelFormat() const
+{
+  return Converter::toPixelFormat(_outputFormat, _pixelFormat);
+}
+
+size_t Demuxer::frameBufferSize() const
+{
+  return Converter::bufferSize(outputSize(), outputPixelFormat());
+}
+
+void Demuxer::setOutput(OutputFormat format, std::optional<gfx::Size> size)
+{
+  _outputFormat = format;
+  _outputSize   = size;
+  _reserveBuffer();
+}
+
+void Demuxer::onFormatChange(FormatChangeCallback callback)
+{
+  _formatChangeCallback = std::move(callback);
+}
+
+// Grows only, a smaller format keeps using the front of the buffer
+void Demuxer::_reserveBuffer()
+{
+  if (_outputBuffer.empty() && _buffer.size() < frameBufferSize())
   {
-    fmt::print(stderr, "Failed to open %s codec\n", av_get_media_type_string(type));
-    return ret;
+    _buffer.resize(frameBufferSize());
   }
-  *stream_idx = stream_index;
-
-  return 0;
 }
 
-// NOLINTNEXTLINE(readability-function-size, readability-function-cognitive-complexity)
-bool create_resources()
+void Demuxer::setOutputBuffer(std::span<uint8_t> buffer)
 {
-  int ret = 0;
-  if (open_codec_context(&g_video_stream_idx,
-                         &g_video_dec_ctx,
-                         g_fmt_ctx,
-                         AVMEDIA_TYPE_VIDEO)
-      >= 0)
+  if (!buffer.empty() && buffer.size() < frameBufferSize())
   {
-    g_video_stream = *std::next(g_fmt_ctx->streams, g_video_stream_idx);
+    throw std::invalid_argument(
+        fmt::format("gfx::Demuxer - output buffer holds {} bytes, frames need {}",
+                    buffer.size(),
+                    frameBufferSize()));
+  }
+  _outputBuffer = buffer;
+  _reserveBuffer();
+}
 
-    g_video_dst_file = makeUniqueFile(g_video_dst_filename, "wb");
+std::span<uint8_t> Demuxer::_destination()
+{
+  return _outputBuffer.empty() ? std::span<uint8_t>{_buffer} : _outputBuffer;
+}
 
-    if (g_video_dst_file == nullptr)
-    {
-      fmt::print(stderr, "Could not open destination file %s\n", g_video_dst_filename);
-      return false;
-    }
+void Demuxer::dumpFormat() const
+{
+  av_dump_format(_formatContext, 0, _uri.c_str(), 0);
+}
 
-    g_width   = g_video_dec_ctx->width;
-    g_height  = g_video_dec_ctx->height;
-    g_pix_fmt = g_video_dec_ctx->pix_fmt;
+void Demuxer::_changeFormat()
+{
+  logger::info("Video format changed from {}x{} {} to {}x{} {}",
+               _width,
+               _height,
+               pixelFormatName(),
+               _frame->width,
+               _frame->height,
+               av_get_pix_fmt_name(static_cast<AVPixelFormat>(_frame->format)));
 
-    ret = av_image_alloc(std::span<uint8_t*>(g_video_dst_data).data(),
-                         std::span<int>(g_video_dst_linesize).data(),
-                         g_width,
-                         g_height,
-                         g_pix_fmt,
-                         1);
-    if (ret < 0)
-    {
-      fmt::print(stderr, "Could not allocate raw video buffer\n");
-      return false;
-    }
-    g_video_dst_bufsize = static_cast<size_t>(ret);
-  }
+  _width       = _frame->width;
+  _height      = _frame->height;
+  _pixelFormat = _frame->format;
 
-  av_dump_format(g_fmt_ctx, 0, g_src_filename, 0);
+  _reserveBuffer();
 
-  if (g_video_stream == nullptr)
+  if (_formatChangeCallback)
   {
-    fmt::print(stderr, "Could not find video stream in the input, aborting\n");
-    return false;
+    _formatChangeCallback(size(), _pixelFormat);
   }
+}
 
-  g_frame = av_frame_alloc();
-  if (g_frame == nullptr)
+int Demuxer::_outputFrame(const FrameCallback& callback)
+{
+  if (_frame->width != _width || _frame->height != _height
+      || _frame->format != _pixelFormat)
   {
-    fmt::print(stderr, "Could not allocate frame\n");
-    return false;
+    _changeFormat();
   }
 
-  g_pkt = av_packet_alloc();
-  if (g_pkt == nullptr)
+  if (_destination().size() < frameBufferSize())
   {
-    fmt::print(stderr, "Could not allocate packet\n");
-    return false;
+    logger::error("Output buffer holds {} bytes, {}x{} {} frames need {}",
+                  _destination().size(),
+                  static_cast<int>(outputSize().width),
+                  static_cast<int>(outputSize().height),
+                  av_get_pix_fmt_name(static_cast<AVPixelFormat>(outputPixelFormat())),
+                  frameBufferSize());
+    return -1;
   }
 
-  if (g_video_stream != nullptr)
+  const std::span<uint8_t> destination = _destination();
+  const gfx::Size dstSize               = outputSize();
+  const int dstFormat                   = outputPixelFormat();
+
+  if (dstFormat == _pixelFormat && dstSize == size())
+  {
+    const int ret = av_image_copy_to_buffer(destination.data(),
+                                            static_cast<int>(destination.size()),
+                                            _frame->data,
+                                            static_cast<const int*>(_frame->linesize),
+                                            static_cast<AVPixelFormat>(_pixelFormat),
+                                            _width,
+                                            _height,
+                                            1);
+    if (ret < 0)
+    {
+      logger::error("Could not copy decoded frame ({})", av_err2str(ret));
+      return ret;
+    }
+  }
+  else
   {
-    fmt::print("Demuxing video from file '%s' into '%s'\n",
-               g_src_filename,
-               g_video_dst_filename);
+    if (!_converter)
+    {
+      _converter = std::make_unique<Converter>(_threads);
+    }
+    _converter->convert(_frame, destination, dstSize, dstFormat);
   }
 
-  return true;
+  const AVStream* stream = *std::next(_formatContext->streams, _streamIndex);
+  const int64_t start    = stream->start_time != AV_NOPTS_VALUE ? stream->start_time
+                                                                : 0;
+  const int64_t timestamp = _frameTimestamp();
+
+  const Frame frame{
+      .data      = destination.first(frameBufferSize()),
+      .size      = dstSize,
+      .format    = dstFormat,
+      .index     = _frameCount++,
+      .timestamp = gfx::time::ms{timestamp != AV_NOPTS_VALUE
+                                     ? av_rescale_q(timestamp - start,
+                                                    stream->time_base,
+                                                    milliseconds)
+                                     : 0},
+  };
+
+  static const trace::EventId decoded = trace::event("decoded");
+  trace::instant(decoded, static_cast<uint64_t>(frame.index));
+
+  return callback(frame) ? 0 : stopRequested;
 }
 
-void destroy_resources()
+int64_t Demuxer::_frameTimestamp() const
 {
-  avcodec_free_context(&g_video_dec_ctx);
-  avformat_close_input(&g_fmt_ctx);
-
-  av_packet_free(&g_pkt);
-  av_frame_free(&g_frame);
-  av_free(g_video_dst_data[0]);
+  return _frame->best_effort_timestamp != AV_NOPTS_VALUE ? _frame->best_effort_timestamp
+                                                         : _frame->pts;
 }
 
-namespace cli_arg
-{
-enum CLIArg
+int Demuxer::_decodePacket(const AVPacket* packet, const FrameCallback& callback)
 {
-  Executable = 0,
-  SourceFile = 1,
-  VideoOut   = 2,
-  NumArgs    = 3
-};
-} // namespace cli_arg
+  // Decoder work only, the callback consumes the frame outside the zones
+  static auto& sendZone    = profile::zone("Demuxer::send_packet");
+  static auto& receiveZone = profile::zone("Demuxer::receive_frame");
 
-// NOLINTNEXTLINE(clang-diagnostic-unsafe-buffer-usage)
-bool parse_args(int argc, const char** argv)
-{
-  if (argc != cli_arg::NumArgs)
+  int ret{};
   {
-    fmt::print(
-        stderr,
-        "usage: %s [input_file] [video_output_file]\n"
-        "API example program to show how to read frames from an input file.\n"
-        "This program reads frames from a file, decodes them, and writes decoded\n"
-        "video frames to a rawvideo file named video_output_file.\n",
-        *std::next(argv, cli_arg::Executable));
-    return false;
+    const profile::Scope scope{sendZone};
+    ret = avcodec_send_packet(_decoderContext, packet);
+  }
+  if (ret < 0)
+  {
+    logger::error("Error submitting a packet for decoding ({})", av_err2str(ret));
+    return ret;
   }
-  g_src_filename       = *std::next(argv, cli_arg::SourceFile);
-  g_video_dst_filename = *std::next(argv, cli_arg::VideoOut);
-
-  return true;
-}
 
-} // namespace
-} // namespace gfx
+  while (ret >= 0)
+  {
+    {
+      const profile::Scope scope{receiveZone};
+      ret = avcodec_receive_frame(_decoderContext, _frame);
+    }
+    if (ret < 0)
+    {
+      if (ret == AVERROR_EOF || ret == AVERROR(EAGAIN))
+      {
+        return 0;
+      }
 
-// NOLINTNEXTLINE(readability-function-size, readability-function-cognitive-complexity)
-int main(int argc, const char** argv)
-{
-  using namespace gfx;
+      logger::error("Error during decoding ({})", av_err2str(ret));
+      return ret;
+    }
 
-  if (!parse_args(argc, argv))
-  {
-    return EXIT_FAILURE;
+    const FrameUnref unref{_frame};
+    ret = _outputFrame(callback);
+    if (ret != 0)
+    {
+      return ret;
+    }
   }
 
-  if (avformat_open_input(&g_fmt_ctx, g_src_filename, nullptr, nullptr) < 0)
+  return 0;
+}
+
+bool Demuxer::decode(const FrameCallback& callback)
+{
+  int ret{0};
+
+  while (ret == 0 && av_read_frame(_formatContext, _packet) >= 0)
   {
-    fmt::print(stderr, "Could not open source file %s\n", g_src_filename);
-    return EXIT_FAILURE;
+    const PacketUnref unref{_packet};
+    if (_packet->stream_index == _streamIndex)
+    {
+      ret = _decodePacket(_packet, callback);
+    }
   }
 
-  if (avformat_find_stream_info(g_fmt_ctx, nullptr) < 0)
+  if (ret == 0)
   {
-    fmt::print(stderr, "Could not find stream information\n");
-    return EXIT_FAILURE;
+    ret = _decodePacket(nullptr, callback);
   }
 
-  int ret = 0;
+  return ret >= 0;
+}
 
-  if (!create_resources())
+int Demuxer::_readKeyframePacket()
+{
+  int ret{0};
+  while ((ret = av_read_frame(_formatContext, _packet)) >= 0)
   {
-    ret = AVERROR(ENOMEM);
-    goto end; // NOLINT(cppcoreguidelines-avoid-goto)
+    if (_packet->stream_index == _streamIndex
+        && (_packet->flags & AV_PKT_FLAG_KEY) != 0)
+    {
+      return 0;
+    }
+    av_packet_unref(_packet);
   }
+  return ret;
+}
 
-  while (av_read_frame(g_fmt_ctx, g_pkt) >= 0)
+// Leaves the first frame later than 'after' in '_frame', AVERROR_EOF at stream end
+int Demuxer::_decodeKeyframe(int64_t after)
+{
+  while (true)
   {
-    if (g_pkt->stream_index == g_video_stream_idx)
+    int ret = avcodec_receive_frame(_decoderContext, _frame);
+    if (ret == 0)
+    {
+      const int64_t timestamp = _frameTimestamp();
+      if (timestamp == AV_NOPTS_VALUE)
+      {
+        logger::error("Sparse decoding needs frame timestamps");
+        return AVERROR(EINVAL);
+      }
+      if (after == AV_NOPTS_VALUE || timestamp > after)
+      {
+        return 0;
+      }
+      av_frame_unref(_frame);
+      continue;
+    }
+    if (ret != AVERROR(EAGAIN))
     {
-      ret = decode_packet(g_video_dec_ctx, g_pkt);
+      return ret;
     }
-    av_packet_unref(g_pkt);
-    if (ret < 0)
+
+    if (_readKeyframePacket() < 0)
+    {
+      ret = avcodec_send_packet(_decoderContext, nullptr);
+    }
+    else
     {
-      break;
+      ret = avcodec_send_packet(_decoderContext, _packet);
+      av_packet_unref(_packet);
+    }
+
+    if (ret < 0 && ret != AVERROR_EOF)
+    {
+      logger::error("Error submitting a packet for decoding ({})", av_err2str(ret));
+      return ret;
     }
   }
+}
 
-  if (g_video_dec_ctx != nullptr)
+// NOLINTNEXTLINE(readability-function-size)
+bool Demuxer::decodeSparse(gfx::time::ms interval, const FrameCallback& callback)
+{
+  if (interval <= gfx::time::ms::zero())
   {
-    decode_packet(g_video_dec_ctx, nullptr);
+    throw std::invalid_argument("gfx::Demuxer - sparse interval must be positive");
   }
 
-  fmt::print("Demuxing succeeded.\n");
+  const AVStream* stream = *std::next(_formatContext->streams, _streamIndex);
+  const int64_t start    = stream->start_time != AV_NOPTS_VALUE ? stream->start_time
+                                                                : 0;
+  const int64_t step     = std::max<int64_t>(
+      av_rescale_q(interval.count(), milliseconds, stream->time_base),
+      1);
+
+  const DiscardGuard discard{_decoderContext};
 
-  if (g_video_stream != nullptr)
+  int64_t target{start};
+  int64_t previous{AV_NOPTS_VALUE};
+
+  while (true)
   {
-    fmt::print("Play the output video file with the command:\n"
-               "ffplay -f rawvideo -pix_fmt %s -video_size %dx%d %s\n",
-               av_get_pix_fmt_name(g_pix_fmt),
-               g_width,
-               g_height,
-               g_video_dst_filename);
-  }
+    // Lands on the closest keyframe at or before the target
+    int ret = av_seek_frame(_formatContext, _streamIndex, target, AVSEEK_FLAG_BACKWARD);
+    if (ret < 0)
+    {
+      logger::error("Could not seek ({})", av_err2str(ret));
+      return false;
+    }
+    avcodec_flush_buffers(_decoderContext);
 
-end:
-  destroy_resources();
+    ret = _decodeKeyframe(previous);
+    if (ret == AVERROR_EOF)
+    {
+      return true;
+    }
+    if (ret < 0)
+    {
+      return false;
+    }
 
-  return static_cast<int>(ret < 0);
+    previous = _frameTimestamp();
+    {
+      const FrameUnref unref{_frame};
+      ret = _outputFrame(callback);
+    }
+
+    if (ret == stopRequested)
+    {
+      return true;
+    }
+    if (ret < 0)
+    {
+      return false;
+    }
+
+    target = std::max(target, previous) + step;
+  }
 }
+} // namespace gfx::utils::video
@@ -13,3 +13,111 @@
  */
 
 #pragma once
+
+#include "utils/converter.hpp"
+#include "utils/frame.hpp"
+#include "vocabulary/size.hpp"
+#include "vocabulary/time.hpp"
+#include "vocabulary/uri.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+struct AVCodecContext;
+struct AVFormatContext;
+struct AVFrame;
+struct AVPacket;
+
+namespace gfx::utils::video
+{
+class Demuxer
+{
+  public:
+    // Return false to stop decoding
+    using FrameCallback = std::function<bool(const Frame&)>;
+
+    // Called with the new decoded size and pixel format before the first frame
+    // in that format is handed out
+    using FormatChangeCallback = std::function<void(const gfx::Size&, int)>;
+
+    // 'threads' limits decoder threads, 0 lets the decoder decide
+    explicit Demuxer(const gfx::URI& uri, int threads = 0);
+    ~Demuxer();
+
+    Demuxer(const Demuxer&)            = delete;
+    Demuxer& operator=(const Demuxer&) = delete;
+    Demuxer(Demuxer&&)                 = delete;
+    Demuxer& operator=(Demuxer&&)      = delete;
+
+    [[nodiscard]] gfx::Size size() const;
+    [[nodiscard]] int pixelFormat() const;
+    [[nodiscard]] const char* pixelFormatName() const;
+    [[nodiscard]] gfx::time::fps frameRate() const;
+
+    // Size and pixel format of frames handed to the callback
+    [[nodiscard]] gfx::Size outputSize() const;
+    [[nodiscard]] int outputPixelFormat() const;
+    [[nodiscard]] size_t frameBufferSize() const;
+
+    // Convert, and scale when 'size' is given, on the decoding thread
+    void setOutput(OutputFormat format, std::optional<gfx::Size> size = std::nullopt);
+
+    // Decode into caller memory of at least frameBufferSize() bytes instead of
+    // the internal buffer, an empty span switches back
+    void setOutputBuffer(std::span<uint8_t> buffer);
+
+    // Streams may switch resolution or pixel format mid-stream, e.g. adaptive
+    // live sources. Without a fixed output size frames follow the new format and
+    // a caller buffer can be replaced from this callback when it no longer fits.
+    void onFormatChange(FormatChangeCallback callback);
+
+    void dumpFormat() const;
+
+    // Decode until end of stream, error or stop requested by callback
+    bool decode(const FrameCallback& callback);
+
+    // Decode one keyframe per 'interval' by seeking between keyframes, every other
+    // frame is discarded before decoding. Meant for thumbnails, leaves the stream
+    // positioned at its end.
+    bool decodeSparse(gfx::time::ms interval, const FrameCallback& callback);
+
+  private:
+    gfx::URI _uri;
+    int _threads{};
+
+    AVFormatContext* _formatContext{nullptr};
+    AVCodecContext* _decoderContext{nullptr};
+    AVFrame* _frame{nullptr};
+    AVPacket* _packet{nullptr};
+    int _streamIndex{-1};
+
+    int _width{};
+    int _height{};
+    int _pixelFormat{};
+
+    OutputFormat _outputFormat{OutputFormat::Native};
+    std::optional<gfx::Size> _outputSize{};
+    std::unique_ptr<Converter> _converter{};
+    std::vector<uint8_t> _buffer{};
+    std::span<uint8_t> _outputBuffer{};
+    FormatChangeCallback _formatChangeCallback{};
+
+    int64_t _frameCount{};
+
+    void _open();
+    void _release();
+    std::span<uint8_t> _destination();
+    void _reserveBuffer();
+    void _changeFormat();
+    int _decodePacket(const AVPacket* packet, const FrameCallback& callback);
+    int _readKeyframePacket();
+    int _decodeKeyframe(int64_t after);
+    [[nodiscard]] int64_t _frameTimestamp() const;
+    int _outputFrame(const FrameCallback& callback);
+};
+} // namespace gfx::utils::video
@@ -0,0 +1,94 @@
+#include "demuxer.hpp"
+
+#include "vocabulary/uri.hpp"
+
+#include <fmt/core.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <string>
+
+namespace
+{
+namespace cli_arg
+{
+enum CLIArg
+{
+  Executable = 0,
+  SourceFile = 1,
+  VideoOut   = 2,
+  NumArgs    = 3
+};
+} // namespace cli_arg
+
+void close_file(FILE* filePtr)
+{
+  // NOLINTNEXTLINE(cert-err33-c)
+  fclose(filePtr);
+}
+
+using UniqueFile = std::unique_ptr<FILE, decltype(&close_file)>;
+} // namespace
+
+// NOLINTNEXTLINE(readability-function-size)
+int main(int argc, const char** argv)
+{
+  if (argc != cli_arg::NumArgs)
+  {
+    fmt::print(
+        stderr,
+        "usage: {} [input_file] [video_output_file]\n"
+        "API example program to show how to read frames from an input file.\n"
+        "This program reads frames from a file, decodes them, and writes decoded\n"
+        "video frames to a rawvideo file named video_output_file.\n",
+        *std::next(argv, cli_arg::Executable));
+    return EXIT_FAILURE;
+  }
+
+  const std::string source{std::string{"file:"} + *std::next(argv, cli_arg::SourceFile)};
+  const char* destination = *std::next(argv, cli_arg::VideoOut);
+
+  try
+  {
+    gfx::utils::video::Demuxer demuxer{gfx::URI{source}};
+    demuxer.dumpFormat();
+
+    const UniqueFile file{fopen(destination, "wb"), &close_file};
+    if (file == nullptr)
+    {
+      fmt::print(stderr, "Could not open destination file {}\n", destination);
+      return EXIT_FAILURE;
+    }
+
+    fmt::print("Demuxing video from file '{}' into '{}'\n", source, destination);
+
+    const bool success = demuxer.decode([&file](const gfx::utils::video::Frame& frame) {
+      fmt::print("video_frame n:{}\n", frame.index);
+      return fwrite(frame.data.data(), 1, frame.data.size(), file.get())
+          == frame.data.size();
+    });
+
+    if (!success)
+    {
+      return EXIT_FAILURE;
+    }
+
+    fmt::print("Demuxing succeeded.\n");
+    fmt::print("Play the output video file with the command:\n"
+               "ffplay -f rawvideo -pix_fmt {} -video_size {}x{} {}\n",
+               demuxer.pixelFormatName(),
+               static_cast<int>(demuxer.size().width),
+               static_cast<int>(demuxer.size().height),
+               destination);
+  }
+  catch (const std::exception& e)
+  {
+    fmt::print(stderr, "{}\n", e.what());
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace gfx::utils::detail
+{
+constexpr size_t cacheLineSize{64};
+
+// Bounded single-producer single-consumer queue, capacity rounded up to a power of two.
+// Neither side blocks, push fails when full and pop when empty.
+template <class T>
+class SpscRing
+{
+  public:
+    explicit SpscRing(size_t capacity)
+        : _slots(std::bit_ceil(std::max<size_t>(capacity, 2))),
+          _mask{_slots.size() - 1}
+    {}
+
+    [[nodiscard]] bool push(T value)
+    {
+      const size_t tail = _tail.load(std::memory_order_relaxed);
+      if (tail - _head.load(std::memory_order_acquire) == _slots.size())
+      {
+        return false;
+      }
+
+      _slots[tail & _mask] = std::move(value);
+      _tail.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+    [[nodiscard]] std::optional<T> pop()
+    {
+      const size_t head = _head.load(std::memory_order_relaxed);
+      if (head == _tail.load(std::memory_order_acquire))
+      {
+        return std::nullopt;
+      }
+
+      std::optional<T> value{std::move(_slots[head & _mask])};
+      _head.store(head + 1, std::memory_order_release);
+      return value;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+      return _head.load(std::memory_order_acquire)
+          == _tail.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] size_t capacity() const
+    {
+      return _slots.size();
+    }
+
+  private:
+    std::vector<T> _slots;
+    size_t _mask;
+
+    // Separate cache lines so producer and consumer do not share writes
+    alignas(cacheLineSize) std::atomic<size_t> _head{0};
+    alignas(cacheLineSize) std::atomic<size_t> _tail{0};
+};
+} // namespace gfx::utils::detail
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "vocabulary/size.hpp"
+#include "vocabulary/time.hpp"
+
+#include <cstdint>
+#include <span>
+
+namespace gfx::utils::video
+{
+// Raw video frame packed into a single contiguous buffer, planes back to back.
+// 'format' is an AVPixelFormat value, 'timestamp' is relative to the stream start.
+struct Frame
+{
+    std::span<const uint8_t> data;
+    gfx::Size size;
+    int format{};
+    int64_t index{};
+    gfx::time::ms timestamp{};
+};
+} // namespace gfx::utils::video
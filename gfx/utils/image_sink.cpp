@@ -0,0 +1,425 @@
+#include "image_sink.hpp"
+
+#include "logger.hpp"
+#include "thread_pool.hpp"
+#include "vocabulary/size.hpp"
+
+#include <fmt/core.h>
+
+#include <stb_image_write.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <latch>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gfx::utils::image
+{
+namespace
+{
+// Below this a strip costs more to schedule than to copy
+constexpr size_t minStripRows{64};
+
+// Calls 'function(first, last)' on strips of rows, the first strip on this thread
+template <typename Function>
+void for_rows(size_t rows, ThreadPool* pool, const Function& function)
+{
+  const size_t strips = pool == nullptr
+                          ? 1
+                          : std::clamp<size_t>(rows / minStripRows, 1, pool->size());
+  if (strips == 1)
+  {
+    function(size_t{0}, rows);
+    return;
+  }
+
+  std::latch done{static_cast<ptrdiff_t>(strips - 1)};
+  for (size_t strip = 1; strip < strips; ++strip)
+  {
+    pool->submit([&, strip] {
+      function(rows * strip / strips, rows * (strip + 1) / strips);
+      done.count_down();
+    });
+  }
+
+  function(size_t{0}, rows / strips);
+  done.wait();
+}
+
+// Source row for output row 'row'
+std::span<const uint8_t> row_of(const Image& image, size_t row)
+{
+  const size_t stride = image.size.width * image.channels;
+  const size_t rows   = image.size.height;
+  const size_t source = image.flip ? rows - row - 1 : row;
+  return image.pixels.subspan(source * stride, stride);
+}
+
+// Rows in file order into 'destination', tightly packed
+void copy_rows(const Image& image,
+               const Options& options,
+               std::span<uint8_t> destination)
+{
+  const size_t stride = image.size.width * image.channels;
+
+  for_rows(image.size.height, options.pool, [&](size_t first, size_t last) {
+    for (size_t row = first; row < last; ++row)
+    {
+      std::ranges::copy(row_of(image, row), destination.subspan(row * stride).begin());
+    }
+  });
+}
+
+// Only copies if the image has to be flipped
+std::span<const uint8_t> top_down(const Image& image,
+                                  const Options& options,
+                                  std::vector<uint8_t>& storage)
+{
+  if (!image.flip)
+  {
+    return image.pixels;
+  }
+
+  storage.resize(image.size.size() * image.channels);
+  copy_rows(image, options, storage);
+  return storage;
+}
+
+void append(void* context, void* data, int size)
+{
+  auto* output      = static_cast<std::vector<uint8_t>*>(context);
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  output->insert(output->end(), bytes, std::next(bytes, size));
+}
+
+std::vector<uint8_t> encode_stb(Format format,
+                                const Image& image,
+                                const Options& options)
+{
+  std::vector<uint8_t> storage{};
+  const std::span<const uint8_t> pixels = top_down(image, options, storage);
+
+  const int width    = image.size.width;
+  const int height   = image.size.height;
+  const auto channel = static_cast<int>(image.channels);
+
+  std::vector<uint8_t> output{};
+  const int written = format == Format::PNG
+                        ? stbi_write_png_to_func(append,
+                                                 &output,
+                                                 width,
+                                                 height,
+                                                 channel,
+                                                 pixels.data(),
+                                                 width * channel)
+                        : stbi_write_jpg_to_func(append,
+                                                 &output,
+                                                 width,
+                                                 height,
+                                                 channel,
+                                                 pixels.data(),
+                                                 options.quality);
+  if (written == 0)
+  {
+    output.clear();
+  }
+  return output;
+}
+
+std::vector<uint8_t> encode_raw(const Image& image, const Options& options)
+{
+  std::vector<uint8_t> output(image.size.size() * image.channels);
+  copy_rows(image, options, output);
+  return output;
+}
+
+std::vector<uint8_t> encode_ppm(const Image& image, const Options& options)
+{
+  if (image.channels != 3 && image.channels != 4)
+  {
+    return {};
+  }
+
+  const std::string header = fmt::format("P6\n{} {}\n255\n",
+                                         static_cast<size_t>(image.size.width),
+                                         static_cast<size_t>(image.size.height));
+
+  const size_t stride = image.size.width * size_t{3};
+  std::vector<uint8_t> output(header.size() + image.size.height * stride);
+  std::ranges::copy(header, output.begin());
+
+  for_rows(image.size.height, options.pool, [&](size_t first, size_t last) {
+    for (size_t row = first; row < last; ++row)
+    {
+      const std::span<const uint8_t> source = row_of(image, row);
+      auto destination = output.begin()
+                       + static_cast<ptrdiff_t>(header.size() + row * stride);
+      for (size_t pixel = 0; pixel < source.size(); pixel += image.channels)
+      {
+        destination = std::copy_n(std::next(source.begin(),
+                                            static_cast<ptrdiff_t>(pixel)),
+                                  3,
+                                  destination);
+      }
+    }
+  });
+
+  return output;
+}
+
+// https://qoiformat.org/qoi-specification.pdf, every op depends on the previous
+// pixel and the index of seen colours, so rows cannot be encoded independently
+namespace qoi
+{
+constexpr uint8_t opIndex{0x00};
+constexpr uint8_t opDiff{0x40};
+constexpr uint8_t opLuma{0x80};
+constexpr uint8_t opRun{0xc0};
+constexpr uint8_t opRGB{0xfe};
+constexpr uint8_t opRGBA{0xff};
+constexpr size_t maxRun{62};
+constexpr size_t endSize{8};
+
+struct Pixel
+{
+    uint8_t r{0};
+    uint8_t g{0};
+    uint8_t b{0};
+    uint8_t a{255}; // NOLINT(readability-magic-numbers)
+
+    constexpr bool operator==(const Pixel&) const = default;
+
+    [[nodiscard]] constexpr size_t hash() const
+    {
+      return (r * 3U + g * 5U + b * 7U + a * 11U) % 64U; // NOLINT
+    }
+};
+
+// Bounds are reserved up front, push_back per op halves the throughput
+class Writer
+{
+  public:
+    explicit Writer(std::vector<uint8_t>& output)
+        : _output{output}
+    {}
+
+    void put(std::initializer_list<uint8_t> bytes)
+    {
+      for (const uint8_t byte : bytes)
+      {
+        _output[_size++] = byte;
+      }
+    }
+
+    void put32(uint32_t value)
+    {
+      put({static_cast<uint8_t>(value >> 24U), // NOLINT
+           static_cast<uint8_t>(value >> 16U), // NOLINT
+           static_cast<uint8_t>(value >> 8U),  // NOLINT
+           static_cast<uint8_t>(value)});
+    }
+
+    void finish()
+    {
+      _output.resize(_size);
+    }
+
+  private:
+    std::vector<uint8_t>& _output;
+    size_t _size{0};
+};
+
+std::vector<uint8_t> encode(const Image& image)
+{
+  if (image.channels != 3 && image.channels != 4)
+  {
+    return {};
+  }
+
+  // Worst case is one RGBA op per pixel
+  std::vector<uint8_t> output(14 + image.size.size() * 5 + endSize); // NOLINT
+  Writer writer{output};
+
+  writer.put({'q', 'o', 'i', 'f'});
+  writer.put32(static_cast<uint32_t>(image.size.width));
+  writer.put32(static_cast<uint32_t>(image.size.height));
+  writer.put({static_cast<uint8_t>(image.channels), 0}); // sRGB with linear alpha
+
+  // Starts out all zero, also alpha, unlike 'previous'
+  std::array<Pixel, 64> seen{}; // NOLINT(readability-magic-numbers)
+  seen.fill(Pixel{0, 0, 0, 0});
+  Pixel previous{};
+  size_t run{0};
+
+  for (size_t row = 0; row < image.size.height; ++row)
+  {
+    const std::span<const uint8_t> source = row_of(image, row);
+    for (size_t offset = 0; offset < source.size(); offset += image.channels)
+    {
+      Pixel pixel{source[offset], source[offset + 1], source[offset + 2]};
+      if (image.channels == 4)
+      {
+        pixel.a = source[offset + 3];
+      }
+
+      if (pixel == previous)
+      {
+        if (++run == maxRun)
+        {
+          writer.put({static_cast<uint8_t>(opRun | (run - 1))});
+          run = 0;
+        }
+        continue;
+      }
+
+      if (run > 0)
+      {
+        writer.put({static_cast<uint8_t>(opRun | (run - 1))});
+        run = 0;
+      }
+
+      const size_t hash = pixel.hash();
+      if (seen[hash] == pixel)
+      {
+        writer.put({static_cast<uint8_t>(opIndex | hash)});
+      }
+      else if (pixel.a == previous.a)
+      {
+        seen[hash] = pixel;
+
+        const auto dr   = static_cast<int8_t>(pixel.r - previous.r);
+        const auto dg   = static_cast<int8_t>(pixel.g - previous.g);
+        const auto db   = static_cast<int8_t>(pixel.b - previous.b);
+        const int drdg  = dr - dg;
+        const int dbdg  = db - dg;
+        const auto tiny = [](int delta) { return delta >= -2 && delta <= 1; };
+
+        // NOLINTBEGIN(readability-magic-numbers)
+        if (tiny(dr) && tiny(dg) && tiny(db))
+        {
+          writer.put({static_cast<uint8_t>(opDiff | (dr + 2) << 4 | (dg + 2) << 2
+                                           | (db + 2))});
+        }
+        else if (drdg >= -8 && drdg <= 7 && dg >= -32 && dg <= 31 && dbdg >= -8
+                 && dbdg <= 7)
+        {
+          writer.put({static_cast<uint8_t>(opLuma | (dg + 32)),
+                      static_cast<uint8_t>((drdg + 8) << 4 | (dbdg + 8))});
+        }
+        // NOLINTEND(readability-magic-numbers)
+        else
+        {
+          writer.put({opRGB, pixel.r, pixel.g, pixel.b});
+        }
+      }
+      else
+      {
+        seen[hash] = pixel;
+        writer.put({opRGBA, pixel.r, pixel.g, pixel.b, pixel.a});
+      }
+
+      previous = pixel;
+    }
+  }
+
+  if (run > 0)
+  {
+    writer.put({static_cast<uint8_t>(opRun | (run - 1))});
+  }
+
+  writer.put({0, 0, 0, 0, 0, 0, 0, 1});
+  writer.finish();
+  return output;
+}
+} // namespace qoi
+} // namespace
+
+std::optional<Format> format_for(std::string_view filename)
+{
+  const size_t dot                 = std::min(filename.rfind('.'), filename.size());
+  const std::string_view extension = filename.substr(dot);
+
+  if (extension == ".png")
+  {
+    return Format::PNG;
+  }
+  if (extension == ".jpg" || extension == ".jpeg")
+  {
+    return Format::JPEG;
+  }
+  if (extension == ".ppm")
+  {
+    return Format::PPM;
+  }
+  if (extension == ".raw" || extension == ".rgba")
+  {
+    return Format::Raw;
+  }
+  if (extension == ".qoi")
+  {
+    return Format::QOI;
+  }
+  return std::nullopt;
+}
+
+std::vector<uint8_t> encode(Format format, const Image& image, const Options& options)
+{
+  const size_t expected = image.size.size() * image.channels;
+  if (image.channels == 0 || image.channels > 4 || image.pixels.size() < expected)
+  {
+    return {};
+  }
+
+  switch (format)
+  {
+    case Format::PNG:
+    case Format::JPEG:
+      return encode_stb(format, image, options);
+    case Format::PPM:
+      return encode_ppm(image, options);
+    case Format::Raw:
+      return encode_raw(image, options);
+    case Format::QOI:
+      return qoi::encode(image);
+  }
+  return {};
+}
+
+bool write(std::string_view filename, const Image& image, const Options& options)
+{
+  const std::optional<Format> format = format_for(filename);
+  if (!format)
+  {
+    logger::error("image::write - did not recognize extension for {}", filename);
+    return false;
+  }
+
+  const std::vector<uint8_t> bytes = encode(*format, image, options);
+  if (bytes.empty())
+  {
+    logger::error("image::write - could not encode {} channels for {}",
+                  image.channels,
+                  filename);
+    return false;
+  }
+
+  std::ofstream file{std::string{filename}, std::ios::binary};
+  file.write(reinterpret_cast<const char*>(bytes.data()), // NOLINT
+             static_cast<std::streamsize>(bytes.size()));
+  if (!file)
+  {
+    logger::error("image::write - could not write {}", filename);
+    return false;
+  }
+  return true;
+}
+} // namespace gfx::utils::image
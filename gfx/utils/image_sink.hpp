@@ -0,0 +1,60 @@
+#pragma once
+
+#include "vocabulary/size.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace gfx::utils
+{
+class ThreadPool;
+} // namespace gfx::utils
+
+namespace gfx::utils::image
+{
+// Encoders shared by the frame dumps. Flipping is a property of the call, stb's
+// global stbi_flip_vertically_on_write is never touched so threads do not race.
+enum class Format
+{
+  PNG,  // .png, stb, slow but small
+  JPEG, // .jpg or .jpeg, stb, lossy
+  PPM,  // .ppm, binary P6, alpha is dropped
+  Raw,  // .raw or .rgba, tightly packed rows without header
+  QOI,  // .qoi, "Quite OK Image" lossless, several times faster than PNG
+};
+
+struct Image
+{
+    std::span<const uint8_t> pixels;
+    gfx::Size size;
+    size_t channels{4};
+
+    // Rows are stored bottom first, as glReadPixels returns them
+    bool flip{false};
+};
+
+struct Options
+{
+    // JPEG only, 1 to 100
+    int quality{100};
+
+    // Rows are split across the pool for formats that allow it. Must not be a
+    // pool the caller runs on, the call blocks until its rows are done.
+    ThreadPool* pool{nullptr};
+};
+
+// Picked from the extension, empty if there is no encoder for it
+[[nodiscard]] std::optional<Format> format_for(std::string_view filename);
+
+// Encoded file contents, empty if the image cannot be encoded in 'format'
+[[nodiscard]] std::vector<uint8_t> encode(Format format,
+                                          const Image& image,
+                                          const Options& options = {});
+
+// Encode by extension and write, logs an error and returns false on failure
+bool write(std::string_view filename, const Image& image, const Options& options = {});
+} // namespace gfx::utils::image
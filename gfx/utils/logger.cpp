@@ -1,28 +1,50 @@
 #include "logger.hpp"
 
+#include "utils/detail/spsc_ring.hpp"
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <fstream>
-#include <iostream>
-#include <sstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 
 namespace gfx::utils::logger
 {
 namespace
 {
-std::string get_name()
+std::string read_name()
 {
   std::string exec_name{};
   std::ifstream("/proc/self/comm") >> exec_name;
-  if (exec_name.size() > 14) // NOLINT
+  return exec_name;
+}
+
+std::string shorten(std::string name)
+{
+  if (name.size() > 14) // NOLINT
   {
-    exec_name[12] = '.';  // NOLINT
-    exec_name[13] = '.';  // NOLINT
-    exec_name[14] = '.';  // NOLINT
-    exec_name[15] = '\0'; // NOLINT
+    name.resize(15);   // NOLINT
+    name[12] = '.';    // NOLINT
+    name[13] = '.';    // NOLINT
+    name[14] = '.';    // NOLINT
   }
-  return exec_name;
+  return name;
 }
 
 constexpr std::string_view gfx = "gfx::";
@@ -37,63 +59,406 @@ constexpr std::string_view bold   = "\x1B[1m";
 constexpr std::string_view reset  = "\x1B[0m";
 }; // namespace ansi
 
-constexpr auto apply = [](std::string_view color) {
-  return [color](std::string_view string) {
-    std::stringstream sstream;
-    sstream << color << string << ansi::white;
-    return sstream.str();
-  };
+constexpr size_t numLevels{4};
+
+struct Style
+{
+    std::string_view color;
+    std::string_view tag;
+};
+
+constexpr std::array<Style, numLevels> styles{
+    Style{ansi::red, "FATAL"},
+    Style{ansi::red, "ERROR"},
+    Style{ansi::yellow, "WARNING"},
+    Style{ansi::cyan, "INFO"},
 };
 
-std::string getPreamble(std::string_view color, std::string_view tag)
-{
-  std::stringstream preamble;
-  preamble << ansi::bold;
-  preamble << gfx;
-  preamble << get_name();
-  preamble << " [";
-  preamble << apply(color)(tag);
-  preamble << "] ";
-  preamble << ansi::reset;
-  return preamble.str();
+// Preambles only change on rename, every thread keeps its own copy and rebuilds it
+// when the generation moves on
+std::mutex g_nameMutex{};
+std::optional<std::string> g_name{};
+std::atomic<uint64_t> g_nameGeneration{0};
+
+std::string process_name()
+{
+  const std::scoped_lock lock{g_nameMutex};
+  if (!g_name)
+  {
+    g_name = shorten(read_name());
+  }
+  return *g_name;
+}
+
+class Preambles
+{
+  public:
+    std::string_view get(Level level)
+    {
+      const uint64_t generation = g_nameGeneration.load(std::memory_order_acquire);
+      if (_generation != generation)
+      {
+        const std::string name = process_name();
+        for (size_t index = 0; index < numLevels; ++index)
+        {
+          _preambles[index] = fmt::format("{}{}{} [{}{}{}] {}",
+                                          ansi::bold,
+                                          gfx,
+                                          name,
+                                          styles[index].color,
+                                          styles[index].tag,
+                                          ansi::white,
+                                          ansi::reset);
+        }
+        _generation = generation;
+      }
+
+      return _preambles[static_cast<size_t>(level)];
+    }
+
+  private:
+    uint64_t _generation{~uint64_t{0}};
+    std::array<std::string, numLevels> _preambles{};
+};
+
+std::string_view getPreamble(Level level)
+{
+  thread_local Preambles preambles{};
+  return preambles.get(level);
+}
+
+// One fwrite per line, stderr is unbuffered
+void write(Level level, fmt::string_view format, fmt::format_args args)
+{
+  thread_local fmt::memory_buffer buffer{};
+  buffer.clear();
+
+  const std::string_view preamble = getPreamble(level);
+  buffer.append(preamble);
+  fmt::vformat_to(std::back_inserter(buffer), format, args);
+  buffer.push_back('\n');
+
+  std::fwrite(buffer.data(), 1, buffer.size(), level == Level::Info ? stdout : stderr);
 }
+
+// Longer messages bypass the queue, see AsyncBackend::push
+constexpr size_t recordTextSize{254};
+
+struct Record
+{
+    Level level{};
+    uint16_t length{};
+    std::array<char, recordTextSize> text{};
+};
+
+class AsyncBackend
+{
+  public:
+    AsyncBackend() = default;
+
+    ~AsyncBackend()
+    {
+      stop();
+      flush();
+    }
+
+    AsyncBackend(const AsyncBackend&)            = delete;
+    AsyncBackend& operator=(const AsyncBackend&) = delete;
+    AsyncBackend(AsyncBackend&&)                 = delete;
+    AsyncBackend& operator=(AsyncBackend&&)      = delete;
+
+    void start(size_t capacity)
+    {
+      const std::scoped_lock lock{_threadMutex};
+      _capacity = capacity;
+      if (!_thread.joinable())
+      {
+        _stop   = false;
+        _thread = std::thread{[this] { _run(); }};
+      }
+    }
+
+    void stop()
+    {
+      {
+        const std::scoped_lock lock{_threadMutex};
+        _stop = true;
+      }
+      _wake.notify_all();
+
+      if (_thread.joinable())
+      {
+        _thread.join();
+      }
+    }
+
+    // Formats straight into the record on the caller, the arguments may not outlive
+    // the call. A message longer than a record writes out the queue and itself
+    // synchronously instead, slower but complete and in order.
+    void push(Level level, fmt::string_view format, fmt::format_args args)
+    {
+      Record record{.level = level};
+
+      const auto result = fmt::vformat_to_n(record.text.data(),
+                                            record.text.size(),
+                                            format,
+                                            args);
+
+      if (result.size > recordTextSize)
+      {
+        const std::scoped_lock lock{_drainMutex};
+        _drain();
+        write(level, format, args);
+        return;
+      }
+
+      record.length = static_cast<uint16_t>(result.size);
+
+      if (!_local().ring.push(record))
+      {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    // Write everything queued so far, callable from any thread
+    void flush()
+    {
+      const std::scoped_lock lock{_drainMutex};
+      _drain();
+    }
+
+    [[nodiscard]] uint64_t dropped() const
+    {
+      return _dropped.load(std::memory_order_relaxed);
+    }
+
+  private:
+    struct Producer
+    {
+        explicit Producer(size_t capacity)
+            : ring{capacity}
+        {}
+
+        utils::detail::SpscRing<Record> ring;
+        std::atomic<bool> closed{false};
+    };
+
+    // Marks the ring of an exited thread so the writer can release it once drained
+    struct LocalProducer
+    {
+        LocalProducer()                                = default;
+        LocalProducer(const LocalProducer&)            = delete;
+        LocalProducer& operator=(const LocalProducer&) = delete;
+        LocalProducer(LocalProducer&&)                 = delete;
+        LocalProducer& operator=(LocalProducer&&)      = delete;
+
+        ~LocalProducer()
+        {
+          if (producer)
+          {
+            producer->closed = true;
+          }
+        }
+
+        std::shared_ptr<Producer> producer{};
+    };
+
+    std::atomic<size_t> _capacity{};
+    std::mutex _producersMutex{};
+    std::vector<std::shared_ptr<Producer>> _producers{};
+
+    // The writer's own copy, the final flush runs after thread_locals are gone
+    std::mutex _drainMutex{};
+    Preambles _preambles{};
+    std::atomic<uint64_t> _dropped{0};
+    uint64_t _reportedDrops{0};
+
+    std::mutex _threadMutex{};
+    std::condition_variable _wake{};
+    bool _stop{false};
+    std::thread _thread{};
+
+    Producer& _local()
+    {
+      thread_local LocalProducer local{};
+      if (!local.producer)
+      {
+        local.producer = std::make_shared<Producer>(_capacity);
+        const std::scoped_lock lock{_producersMutex};
+        _producers.push_back(local.producer);
+      }
+      return *local.producer;
+    }
+
+    // Caller holds '_drainMutex', the single consumer of every ring
+    bool _drain()
+    {
+      std::string out{};
+      std::string err{};
+
+      {
+        const std::scoped_lock lock{_producersMutex};
+        for (const auto& producer : _producers)
+        {
+          while (auto record = producer->ring.pop())
+          {
+            std::string& batch = record->level == Level::Info ? out : err;
+            batch += _preambles.get(record->level);
+            batch.append(record->text.data(), record->length);
+            batch += '\n';
+          }
+        }
+
+        std::erase_if(_producers, [](const auto& producer) {
+          return producer->closed && producer->ring.empty();
+        });
+      }
+
+      const uint64_t dropped = _dropped.load(std::memory_order_relaxed);
+      if (dropped != _reportedDrops)
+      {
+        err += _preambles.get(Level::Warning);
+        err += std::to_string(dropped - _reportedDrops);
+        err += " log records dropped, queue full\n";
+        _reportedDrops = dropped;
+      }
+
+      std::fwrite(out.data(), 1, out.size(), stdout);
+      std::fwrite(err.data(), 1, err.size(), stderr);
+      std::fflush(stdout);
+
+      return !out.empty() || !err.empty();
+    }
+
+    void _run()
+    {
+      constexpr std::chrono::milliseconds idle{2};
+
+      std::unique_lock lock{_threadMutex};
+      while (!_stop)
+      {
+        lock.unlock();
+        bool written{false};
+        {
+          const std::scoped_lock drainLock{_drainMutex};
+          written = _drain();
+        }
+        lock.lock();
+
+        if (!written)
+        {
+          _wake.wait_for(lock, idle, [this] { return _stop; });
+        }
+      }
+    }
+};
+
+std::atomic<bool> g_async{false};
+
+AsyncBackend& async_backend()
+{
+  static AsyncBackend backend{};
+  return backend;
+}
+
 } // namespace
 
-void fatal(std::string_view msg)
+namespace detail
 {
-  const std::string preamble = getPreamble(ansi::red, "FATAL");
-  std::cerr << preamble << msg << '\n';
-  std::abort();
+void vlog(Level level, fmt::string_view format, fmt::format_args args)
+{
+  if (g_async.load(std::memory_order_acquire))
+  {
+    async_backend().push(level, format, args);
+    return;
+  }
+
+  write(level, format, args);
 }
 
-void fatal(std::string_view msg, std::string_view info)
+void vlog(Level level, RateLimit& site, fmt::string_view format, fmt::format_args args)
 {
-  const std::string preamble = getPreamble(ansi::red, "FATAL");
-  std::cerr << preamble << msg << info << '\n';
+  uint64_t suppressed{};
+  if (!site.acquire(suppressed))
+  {
+    return;
+  }
+
+  if (suppressed == 0)
+  {
+    vlog(level, format, args);
+    return;
+  }
+
+  const std::string message = fmt::vformat(format, args);
+  vlog(level,
+       "{} ({} similar lines suppressed)",
+       fmt::make_format_args(message, suppressed));
+}
+
+void vlog(Level level,
+          Deduplicate& site,
+          fmt::string_view format,
+          fmt::format_args args)
+{
+  // Compared by hash, a collision at worst hides one distinct line
+  thread_local fmt::memory_buffer buffer{};
+  buffer.clear();
+  fmt::vformat_to(std::back_inserter(buffer), format, args);
+
+  const std::string_view message{buffer.data(), buffer.size()};
+  const auto decision = site.check(std::hash<std::string_view>{}(message));
+
+  if (decision.repeats != 0)
+  {
+    vlog(level, "message repeated {} times", fmt::make_format_args(decision.repeats));
+  }
+
+  if (decision.write)
+  {
+    vlog(level, "{}", fmt::make_format_args(message));
+  }
+}
+
+void vfatal(fmt::string_view format, fmt::format_args args)
+{
+  flush();
+  write(Level::Fatal, format, args);
   std::abort();
 }
+} // namespace detail
+
+void enable_async(size_t capacity)
+{
+  async_backend().start(capacity);
+  g_async.store(true, std::memory_order_release);
+}
 
-void error(std::string_view msg)
+void disable_async()
 {
-  const std::string preamble = getPreamble(ansi::red, "ERROR");
-  std::cerr << preamble << msg << '\n';
+  g_async.store(false, std::memory_order_release);
+  async_backend().stop();
+  async_backend().flush();
 }
 
-void warning(std::string_view msg)
+void flush()
 {
-  const std::string preamble = getPreamble(ansi::yellow, "WARNING");
-  std::cerr << preamble << msg << '\n';
+  if (g_async.load(std::memory_order_acquire))
+  {
+    async_backend().flush();
+  }
+  std::fflush(stdout);
 }
 
-void info(std::string_view msg)
+void rename(std::string_view name)
 {
-  const std::string preamble = getPreamble(ansi::cyan, "INFO");
-  std::cout << preamble << msg << '\n';
+  const std::scoped_lock lock{g_nameMutex};
+  g_name = shorten(name.empty() ? read_name() : std::string{name});
+  g_nameGeneration.fetch_add(1, std::memory_order_release);
 }
 
-void info(std::string_view msg, std::string_view info)
+uint64_t dropped()
 {
-  const std::string preamble = getPreamble(ansi::cyan, "INFO");
-  std::cout << preamble << msg << info << '\n';
+  return async_backend().dropped();
 }
 } // namespace gfx::utils::logger
@@ -1,16 +1,171 @@
 #pragma once
 
+#include <fmt/core.h>
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <string_view>
 
+// Calls above GFX_LOG_LEVEL lose their formatting and I/O at compile time, their
+// arguments are still evaluated, guard costly ones with enabled().
+// 0 fatal, 1 error, 2 warning, 3 info
+#ifndef GFX_LOG_LEVEL
+#define GFX_LOG_LEVEL 3
+#endif
+
 namespace gfx::utils::logger
 {
-[[noreturn]] void fatal(std::string_view msg);
-[[noreturn]] void fatal(std::string_view msg, std::string_view info);
+enum class Level : uint8_t
+{
+  Fatal,
+  Error,
+  Warning,
+  Info
+};
+
+constexpr Level compiledLevel{GFX_LOG_LEVEL};
+
+[[nodiscard]] constexpr bool enabled(Level level)
+{
+  return level <= compiledLevel;
+}
+
+// Call site state for hot loops, keep it static next to the call, e.g.
+//   static logger::RateLimit site{5};
+//   logger::warning(site, "dropped frame {}", index);
+// writes at most five lines a second from that site. The next written line
+// reports how many were suppressed in between.
+class RateLimit
+{
+  public:
+    explicit constexpr RateLimit(uint32_t perSecond)
+        : _perSecond{perSecond}
+    {}
+
+    // False once this second's budget is spent, 'suppressed' returns the lines
+    // dropped since the last allowed one
+    [[nodiscard]] bool acquire(uint64_t& suppressed);
+
+    // The same at 'second' of a monotonic clock, so tests step time themselves
+    [[nodiscard]] bool acquire(uint64_t& suppressed, uint32_t second);
+
+  private:
+    uint32_t _perSecond;
+    std::atomic<uint64_t> _window{0}; // second << 32 | lines written in it
+    std::atomic<uint64_t> _suppressed{0};
+};
+
+// Call site state for repeat suppression, a line identical to the previous one
+// from the same site is counted instead of written. 'message repeated N times'
+// follows before the next different line and at most once a second otherwise.
+class Deduplicate
+{
+  public:
+    struct Decision
+    {
+        bool write;
+        uint64_t repeats; // to report first, 0 for none
+    };
+
+    [[nodiscard]] Decision check(uint64_t hash);
+
+  private:
+    std::atomic<uint64_t> _hash{0};
+    std::atomic<uint64_t> _repeats{0};
+    std::atomic<uint32_t> _reported{0};
+};
+
+namespace detail
+{
+void vlog(Level level, fmt::string_view format, fmt::format_args args);
+void vlog(Level level, RateLimit& site, fmt::string_view format, fmt::format_args args);
+void vlog(Level level,
+          Deduplicate& site,
+          fmt::string_view format,
+          fmt::format_args args);
+[[noreturn]] void vfatal(fmt::string_view format, fmt::format_args args);
 
-void error(std::string_view msg);
+template <class Site>
+concept CallSite = std::same_as<Site, RateLimit> || std::same_as<Site, Deduplicate>;
+} // namespace detail
 
-void warning(std::string_view msg);
+// Queue error, warning and info records in a per-thread ring and write them in
+// batches from a background thread. A full ring drops the record and counts it.
+// fatal stays synchronous and writes out the queue before aborting.
+void enable_async(size_t capacity = 1024);
+void disable_async();
 
-void info(std::string_view msg);
-void info(std::string_view msg, std::string_view info);
+// Write out everything logged so far
+void flush();
+
+[[nodiscard]] uint64_t dropped();
+
+// The process name in every line is read once, rename after changing it or to
+// override it, an empty name reads it again
+void rename(std::string_view name = {});
+
+// Format strings are checked at compile time, pass runtime strings as "{}".
+// Levels compiled out skip the formatting, not the evaluation of 'args'.
+template <class... Args>
+[[noreturn]] void fatal(fmt::format_string<Args...> format, Args&&... args)
+{
+  detail::vfatal(format, fmt::make_format_args(args...));
+}
+
+template <class... Args>
+void error(fmt::format_string<Args...> format, Args&&... args)
+{
+  if constexpr (enabled(Level::Error))
+  {
+    detail::vlog(Level::Error, format, fmt::make_format_args(args...));
+  }
+}
+
+template <class... Args>
+void warning(fmt::format_string<Args...> format, Args&&... args)
+{
+  if constexpr (enabled(Level::Warning))
+  {
+    detail::vlog(Level::Warning, format, fmt::make_format_args(args...));
+  }
+}
+
+template <class... Args>
+void info(fmt::format_string<Args...> format, Args&&... args)
+{
+  if constexpr (enabled(Level::Info))
+  {
+    detail::vlog(Level::Info, format, fmt::make_format_args(args...));
+  }
+}
+
+// Same as above through the state of one call site, see RateLimit and Deduplicate
+template <detail::CallSite Site, class... Args>
+void error(Site& site, fmt::format_string<Args...> format, Args&&... args)
+{
+  if constexpr (enabled(Level::Error))
+  {
+    detail::vlog(Level::Error, site, format, fmt::make_format_args(args...));
+  }
+}
+
+template <detail::CallSite Site, class... Args>
+void warning(Site& site, fmt::format_string<Args...> format, Args&&... args)
+{
+  if constexpr (enabled(Level::Warning))
+  {
+    detail::vlog(Level::Warning, site, format, fmt::make_format_args(args...));
+  }
+}
+
+template <detail::CallSite Site, class... Args>
+void info(Site& site, fmt::format_string<Args...> format, Args&&... args)
+{
+  if constexpr (enabled(Level::Info))
+  {
+    detail::vlog(Level::Info, site, format, fmt::make_format_args(args...));
+  }
+}
 } // namespace gfx::utils::logger
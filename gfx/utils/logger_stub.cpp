@@ -1,25 +1,46 @@
 #include "logger.hpp"
 
+#include <fmt/core.h>
+
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
 #include <string_view>
 
 namespace gfx::utils::logger
 {
-void fatal(std::string_view /*msg*/)
+namespace detail
 {
-  throw std::runtime_error("called [[noreturn]] stub");
-}
+void vlog(Level /*level*/, fmt::string_view /*format*/, fmt::format_args /*args*/) {}
+
+void vlog(Level /*level*/,
+          RateLimit& /*site*/,
+          fmt::string_view /*format*/,
+          fmt::format_args /*args*/)
+{}
 
-void fatal(std::string_view /*msg*/, std::string_view /*info*/)
+void vlog(Level /*level*/,
+          Deduplicate& /*site*/,
+          fmt::string_view /*format*/,
+          fmt::format_args /*args*/)
+{}
+
+void vfatal(fmt::string_view /*format*/, fmt::format_args /*args*/)
 {
   throw std::runtime_error("called [[noreturn]] stub");
 }
+} // namespace detail
+
+void enable_async(size_t /*capacity*/) {}
 
-void error(std::string_view /*msg*/) {}
+void disable_async() {}
 
-void warning(std::string_view /*msg*/) {}
+void flush() {}
 
-void info(std::string_view /*msg*/) {}
+uint64_t dropped()
+{
+  return 0;
+}
 
-void info(std::string_view /*msg*/, std::string_view /*info*/) {}
+void rename(std::string_view /*name*/) {}
 } // namespace gfx::utils::logger
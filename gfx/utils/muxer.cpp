@@ -15,8 +15,12 @@
 #include "muxer.hpp"
 
 #include "utils/logger.hpp"
+#include "utils/profile.hpp"
+#include "utils/trace.hpp"
 #include "vocabulary/time.hpp"
 
+#include <fmt/format.h>
+
 extern "C"
 {
 #include <libavcodec/avcodec.h>
@@ -29,6 +33,7 @@ extern "C"
 #include <libavutil/dict.h>
 #include <libavutil/error.h>
 #include <libavutil/frame.h>
+#include <libavutil/imgutils.h>
 #include <libavutil/mathematics.h>
 #include <libavutil/pixfmt.h>
 #include <libavutil/rational.h>
@@ -39,33 +44,19 @@ extern "C"
 
 #include "utils/libav_string_fix.hpp"
 
+#include <array>
 #include <cerrno>
 #include <cstdint>
 #include <cstdio>
 #include <iterator>
+#include <memory>
 #include <span>
+#include <stdexcept>
 
 namespace gfx::utils::video
 {
-namespace
-{
-struct Size
+namespace detail
 {
-    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-    Size(int widthParam, int heightParam)
-        : width{widthParam},
-          height{heightParam}
-    {}
-
-    explicit Size(const gfx::Size& size)
-        : width{static_cast<int>(size.width)},
-          height{static_cast<int>(size.height)}
-    {}
-
-    int width{};
-    int height{};
-};
-
 struct OutputStream
 {
     AVStream* st{nullptr};
@@ -86,18 +77,46 @@ struct OutputStream
     SwsContext* sws_ctx{nullptr};
     SwrContext* swr_ctx{nullptr};
 };
+} // namespace detail
 
+namespace
+{
+using detail::OutputStream;
+
+struct Size
+{
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    Size(int widthParam, int heightParam)
+        : width{widthParam},
+          height{heightParam}
+    {}
+
+    explicit Size(const gfx::Size& size)
+        : width{static_cast<int>(size.width)},
+          height{static_cast<int>(size.height)}
+    {}
+
+    int width{};
+    int height{};
+};
+
+// 0 when the frame was consumed, 1 once the encoder is flushed, a negative
+// AVERROR when encoding or writing failed
 int write_frame(AVFormatContext* fmt_ctx,
                 AVCodecContext* codecContext,
                 AVStream* stream,
                 AVFrame* frame,
                 AVPacket* pkt)
 {
+  static auto& zone = profile::zone("Muxer::write_frame");
+  const profile::Scope scope{zone};
+
   int ret{};
   ret = avcodec_send_frame(codecContext, frame);
   if (ret < 0)
   {
-    logger::fatal("Error sending a frame to the encoder: ", av_err2str(ret));
+    logger::error("Error sending a frame to the encoder: {}", av_err2str(ret));
+    return ret;
   }
 
   while (ret >= 0)
@@ -111,7 +130,8 @@ int write_frame(AVFormatContext* fmt_ctx,
 
     if (ret < 0) [[unlikely]]
     {
-      logger::fatal("Error encoding a frame: ", av_err2str(ret));
+      logger::error("Error encoding a frame: {}", av_err2str(ret));
+      return ret;
     }
 
     av_packet_rescale_ts(pkt, codecContext->time_base, stream->time_base);
@@ -120,7 +140,8 @@ int write_frame(AVFormatContext* fmt_ctx,
     ret = av_interleaved_write_frame(fmt_ctx, pkt);
     if (ret < 0)
     {
-      logger::fatal("Error while writing output packet: ", av_err2str(ret));
+      logger::error("Error while writing output packet: {}", av_err2str(ret));
+      return ret;
     }
   }
 
@@ -133,27 +154,29 @@ void add_stream(OutputStream* ost,
                 const AVCodec** codec,
                 AVCodecID codec_id,
                 const Size& size,
-                uint32_t frameRate)
+                uint32_t frameRate,
+                int threads)
 {
   AVCodecContext* codecContext{nullptr};
   *codec = avcodec_find_encoder(codec_id);
 
   if (*codec == nullptr)
   {
-    logger::fatal("Could not find encoder for ", avcodec_get_name(codec_id));
+    throw std::runtime_error(
+        fmt::format("Could not find encoder for {}", avcodec_get_name(codec_id)));
   }
 
   ost->tmp_pkt = av_packet_alloc();
   if (ost->tmp_pkt == nullptr)
   {
-    logger::fatal("Could not allocate AVPacket");
+    throw std::runtime_error("Could not allocate AVPacket");
   }
 
   ost->st = avformat_new_stream(formatContext, nullptr);
 
   if (ost->st == nullptr)
   {
-    logger::fatal("Could not allocate stream");
+    throw std::runtime_error("Could not allocate stream");
   }
 
   ost->st->id  = static_cast<int>(formatContext->nb_streams - 1);
@@ -161,7 +184,7 @@ void add_stream(OutputStream* ost,
 
   if (codecContext == nullptr)
   {
-    logger::fatal("Could not alloc an encoding context");
+    throw std::runtime_error("Could not alloc an encoding context");
   }
 
   ost->enc = codecContext;
@@ -177,6 +200,8 @@ void add_stream(OutputStream* ost,
     ost->st->time_base      = AVRational{1, static_cast<int>(frameRate)};
     codecContext->time_base = ost->st->time_base;
 
+    codecContext->thread_count = threads;
+
     codecContext->gop_size = 12; // NOLINT(readability-magic-numbers)
     codecContext->pix_fmt  = AV_PIX_FMT_YUV420P;
     if (codecContext->codec_id == AV_CODEC_ID_MPEG2VIDEO)
@@ -219,7 +244,8 @@ AVFrame* alloc_picture(AVPixelFormat pix_fmt, const Size& size)
   ret = av_frame_get_buffer(picture, 0);
   if (ret < 0) [[unlikely]]
   {
-    logger::fatal("Could not allocate frame data");
+    av_frame_free(&picture);
+    throw std::runtime_error("Could not allocate frame data");
   }
 
   return picture;
@@ -240,14 +266,15 @@ void open_video(AVFormatContext* /*oc*/,
   av_dict_free(&opt);
   if (ret < 0) [[unlikely]]
   {
-    logger::fatal("Could not open video codec: ", av_err2str(ret));
+    throw std::runtime_error(
+        fmt::format("Could not open video codec: {}", av_err2str(ret)));
   }
 
   ost->frame = alloc_picture(codecContext->pix_fmt,
                              Size{codecContext->width, codecContext->height});
   if (ost->frame == nullptr) [[unlikely]]
   {
-    logger::fatal("Could not allocate video frame");
+    throw std::runtime_error("Could not allocate video frame");
   }
 
   ost->tmp_frame = nullptr;
@@ -257,14 +284,14 @@ void open_video(AVFormatContext* /*oc*/,
                                    Size{codecContext->width, codecContext->height});
     if (ost->tmp_frame == nullptr) [[unlikely]]
     {
-      logger::fatal("Could not allocate temporary picture");
+      throw std::runtime_error("Could not allocate temporary picture");
     }
   }
 
   ret = avcodec_parameters_from_context(ost->st->codecpar, codecContext);
   if (ret < 0) [[unlikely]]
   {
-    logger::fatal("Could not copy the stream parameters");
+    throw std::runtime_error("Could not copy the stream parameters");
   }
 }
 
@@ -309,7 +336,7 @@ AVFrame* get_video_frame(OutputStream* ost, int64_t duration)
 
   if (av_frame_make_writable(ost->frame) < 0) [[unlikely]]
   {
-    logger::fatal("Frame not writable");
+    throw std::runtime_error("Frame not writable");
   }
 
   fill_yuv_image(ost->frame,
@@ -321,15 +348,57 @@ AVFrame* get_video_frame(OutputStream* ost, int64_t duration)
   return ost->frame;
 }
 
-int write_video_frame(AVFormatContext* formatContext,
-                      OutputStream* ost,
-                      int64_t duration)
+void convert_frame(OutputStream* ost, const Frame& frame)
 {
-  return write_frame(formatContext,
-                     ost->enc,
-                     ost->st,
-                     get_video_frame(ost, duration),
-                     ost->tmp_pkt);
+  AVCodecContext* codecContext{ost->enc};
+
+  if (av_frame_make_writable(ost->frame) < 0) [[unlikely]]
+  {
+    throw std::runtime_error("Frame not writable");
+  }
+
+  const Size srcSize{frame.size};
+  const auto srcFormat = static_cast<AVPixelFormat>(frame.format);
+
+  std::array<uint8_t*, 4> srcData{};
+  std::array<int, 4> srcLinesize{};
+  if (av_image_fill_arrays(srcData.data(),
+                           srcLinesize.data(),
+                           frame.data.data(),
+                           srcFormat,
+                           srcSize.width,
+                           srcSize.height,
+                           1)
+      < 0) [[unlikely]]
+  {
+    throw std::runtime_error("Could not map raw frame data");
+  }
+
+  ost->sws_ctx = sws_getCachedContext(ost->sws_ctx,
+                                      srcSize.width,
+                                      srcSize.height,
+                                      srcFormat,
+                                      codecContext->width,
+                                      codecContext->height,
+                                      codecContext->pix_fmt,
+                                      SWS_BICUBIC,
+                                      nullptr,
+                                      nullptr,
+                                      nullptr);
+  if (ost->sws_ctx == nullptr) [[unlikely]]
+  {
+    throw std::runtime_error("Could not initialize the conversion context");
+  }
+
+  sws_scale(ost->sws_ctx,
+            srcData.data(),
+            srcLinesize.data(),
+            0,
+            srcSize.height,
+            static_cast<uint8_t* const*>(ost->frame->data),
+            static_cast<const int*>(ost->frame->linesize));
+
+  ost->frame->pts = ost->next_pts++;
 }
 
 void close_stream(AVFormatContext* /*oc*/, OutputStream* ost)
@@ -343,101 +412,145 @@ void close_stream(AVFormatContext* /*oc*/, OutputStream* ost)
 }
 } // namespace
 
-// NOLINTNEXTLINE(readability-function-size,readability-function-cognitive-complexity)
-Muxer::Muxer(gfx::URI uri,
-             gfx::Size size,
-             gfx::time::ms duration,
-             gfx::time::fps frameRate)
+Muxer::Muxer(gfx::URI uri, gfx::Size size, gfx::time::fps frameRate, int threads)
     : _uri{uri},
       _size{size},
-      _duration{duration},
-      _frameRate{frameRate}
+      _frameRate{frameRate},
+      _stream{std::make_unique<OutputStream>()}
 {
-  OutputStream video_st{nullptr};
-  const AVOutputFormat* fmt{nullptr};
+  try
+  {
+    _open(threads);
+  }
+  catch (...)
+  {
+    _release();
+    throw;
+  }
+}
+
+Muxer::~Muxer()
+{
+  if (write_frame(_formatContext, _stream->enc, _stream->st, nullptr, _stream->tmp_pkt)
+      < 0)
+  {
+    logger::error("Could not flush the encoder: {}", _uri.c_str());
+  }
+
+  av_write_trailer(_formatContext);
+
+  _release();
+}
+
+bool Muxer::write(const Frame& frame)
+{
+  static const trace::EventId encode = trace::event("encode");
+  const trace::Scope scope{encode, static_cast<uint64_t>(frame.index)};
+
+  convert_frame(_stream.get(), frame);
+  return write_frame(_formatContext,
+                     _stream->enc,
+                     _stream->st,
+                     _stream->frame,
+                     _stream->tmp_pkt)
+      >= 0;
+}
+
+bool Muxer::writeTestPattern(gfx::time::ms duration)
+{
+  constexpr uint32_t ms_to_sec{1000};
+  while (AVFrame* frame = get_video_frame(_stream.get(), duration.count() / ms_to_sec))
+  {
+    if (write_frame(_formatContext, _stream->enc, _stream->st, frame, _stream->tmp_pkt)
+        < 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// NOLINTNEXTLINE(readability-function-size,readability-function-cognitive-complexity)
+void Muxer::_open(int threads)
+{
+  const AVOutputFormat* outputFormat{nullptr};
   const char* filename{nullptr};
-  AVFormatContext* outputFormatContext{nullptr};
   const AVCodec* video_codec{nullptr};
   int ret{};
-  int have_video{0};
-  int encode_video{0};
   AVDictionary* opt{nullptr};
 
   filename = _uri.c_str();
 
-  avformat_alloc_output_context2(&outputFormatContext, nullptr, nullptr, filename);
-  if (outputFormatContext == nullptr) [[unlikely]]
+  avformat_alloc_output_context2(&_formatContext, nullptr, nullptr, filename);
+  if (_formatContext == nullptr) [[unlikely]]
   {
     puts("Could not deduce output format from file extension: using mpegts.");
-    avformat_alloc_output_context2(&outputFormatContext, nullptr, "mpegts", filename);
+    avformat_alloc_output_context2(&_formatContext, nullptr, "mpegts", filename);
   }
 
-  if (outputFormatContext == nullptr) [[unlikely]]
+  if (_formatContext == nullptr) [[unlikely]]
   {
-    logger::fatal("outputFormatContext == nullptr");
+    throw std::runtime_error(fmt::format("Could not create an output context: {}",
+                                         filename));
   }
 
-  fmt = outputFormatContext->oformat;
+  outputFormat = _formatContext->oformat;
 
-  if (fmt->video_codec != AV_CODEC_ID_NONE) [[likely]]
+  if (outputFormat->video_codec == AV_CODEC_ID_NONE) [[unlikely]]
   {
-    logger::info("Not deducing codec from format context, using: ",
-                 avcodec_get_name(AV_CODEC_ID_H264));
+    throw std::runtime_error(
+        fmt::format("Output format does not support video: {}", filename));
+  }
 
-    add_stream(&video_st,
-               outputFormatContext,
-               &video_codec,
-               AV_CODEC_ID_H264,
-               Size(_size),
-               _frameRate);
+  logger::info("Not deducing codec from format context, using: {}",
+               avcodec_get_name(AV_CODEC_ID_H264));
 
-    have_video   = 1;
-    encode_video = 1;
-  }
+  add_stream(_stream.get(),
+             _formatContext,
+             &video_codec,
+             AV_CODEC_ID_H264,
+             Size(_size),
+             _frameRate,
+             threads);
 
-  if (have_video != 0) [[likely]]
-  {
-    open_video(outputFormatContext, video_codec, &video_st, opt);
-  }
+  open_video(_formatContext, video_codec, _stream.get(), opt);
 
-  av_dump_format(outputFormatContext, 0, filename, 1);
+  av_dump_format(_formatContext, 0, filename, 1);
 
   // NOLINTNEXTLINE(hicpp-signed-bitwise)
-  if ((fmt->flags & AVFMT_NOFILE) == 0)
+  if ((outputFormat->flags & AVFMT_NOFILE) == 0)
   {
-    ret = avio_open(&outputFormatContext->pb, filename, AVIO_FLAG_WRITE);
+    ret = avio_open(&_formatContext->pb, filename, AVIO_FLAG_WRITE);
     if (ret < 0) [[unlikely]]
     {
-      logger::fatal("Could not open: ", filename);
+      throw std::runtime_error(fmt::format("Could not open: {}", filename));
     }
   }
 
-  ret = avformat_write_header(outputFormatContext, &opt);
+  ret = avformat_write_header(_formatContext, &opt);
   if (ret < 0) [[unlikely]]
   {
-    logger::fatal("Error occurred when opening output file: ", av_err2str(ret));
+    throw std::runtime_error(fmt::format("Error occurred when opening output file: {}",
+                                         av_err2str(ret)));
   }
+}
 
-  while (encode_video != 0)
-  {
-    constexpr uint32_t ms_to_sec{1000};
-    encode_video = static_cast<int>(
-        !static_cast<bool>(write_video_frame(outputFormatContext,
-                                             &video_st,
-                                             _duration.count() / ms_to_sec)));
-  }
-  av_write_trailer(outputFormatContext);
+void Muxer::_release()
+{
+  close_stream(_formatContext, _stream.get());
 
-  if (have_video != 0)
+  if (_formatContext == nullptr)
   {
-    close_stream(outputFormatContext, &video_st);
+    return;
   }
+
   // NOLINTNEXTLINE(hicpp-signed-bitwise)
-  if ((fmt->flags & AVFMT_NOFILE) == 0)
+  if ((_formatContext->oformat->flags & AVFMT_NOFILE) == 0)
   {
-    avio_closep(&outputFormatContext->pb);
+    avio_closep(&_formatContext->pb);
   }
 
-  avformat_free_context(outputFormatContext);
+  avformat_free_context(_formatContext);
+  _formatContext = nullptr;
 }
 } // namespace gfx::utils::video
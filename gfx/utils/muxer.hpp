@@ -14,24 +14,54 @@
 
 #pragma once
 
+#include "utils/frame.hpp"
 #include "vocabulary/size.hpp"
 #include "vocabulary/time.hpp"
 #include "vocabulary/uri.hpp"
 
+#include <memory>
+
+struct AVFormatContext;
+
 namespace gfx::utils::video
 {
+namespace detail
+{
+struct OutputStream;
+} // namespace detail
+
+// H264 encoder writing to the container deduced from the uri, trailer is written
+// when the muxer is destroyed. Throws std::runtime_error when the output cannot
+// be opened, so one bad output does not take the process down.
 class Muxer
 {
   public:
-    Muxer(gfx::URI uri,
-          gfx::Size size,
-          gfx::time::ms duration,
-          gfx::time::fps frameRate);
+    // 'threads' limits encoder threads, 0 lets the encoder decide
+    Muxer(gfx::URI uri, gfx::Size size, gfx::time::fps frameRate, int threads = 0);
+    ~Muxer();
+
+    Muxer(const Muxer&)            = delete;
+    Muxer& operator=(const Muxer&) = delete;
+    Muxer(Muxer&&)                 = delete;
+    Muxer& operator=(Muxer&&)      = delete;
+
+    // Encode a raw frame, scaled and converted to the output size and format,
+    // false when encoding or writing failed. Throws std::runtime_error when the
+    // frame cannot be converted, the muxer stays usable for the next one.
+    [[nodiscard]] bool write(const Frame& frame);
+
+    // Encode a generated test pattern for 'duration', false or throws as write
+    [[nodiscard]] bool writeTestPattern(gfx::time::ms duration);
 
   private:
     gfx::URI _uri;
     gfx::Size _size;
-    gfx::time::ms _duration;
     gfx::time::fps _frameRate;
+
+    AVFormatContext* _formatContext{nullptr};
+    std::unique_ptr<detail::OutputStream> _stream;
+
+    void _open(int threads);
+    void _release();
 };
 } // namespace gfx::utils::video
@@ -0,0 +1,282 @@
+#include "profile.hpp"
+
+#include "utils/logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace gfx::utils::profile
+{
+namespace
+{
+struct Registry
+{
+    std::mutex mutex{};
+    std::deque<Zone> zones{};
+};
+
+Registry& registry()
+{
+  static Registry instance{};
+  return instance;
+}
+
+class SummaryThread
+{
+  public:
+    SummaryThread() = default;
+
+    ~SummaryThread()
+    {
+      stop();
+    }
+
+    SummaryThread(const SummaryThread&)            = delete;
+    SummaryThread& operator=(const SummaryThread&) = delete;
+    SummaryThread(SummaryThread&&)                 = delete;
+    SummaryThread& operator=(SummaryThread&&)      = delete;
+
+    void start(std::chrono::milliseconds interval)
+    {
+      stop();
+
+      const std::scoped_lock lock{_mutex};
+      _stop     = false;
+      _interval = interval;
+      _thread   = std::thread{[this] { _run(); }};
+    }
+
+    void stop()
+    {
+      {
+        const std::scoped_lock lock{_mutex};
+        _stop = true;
+      }
+      _wake.notify_all();
+
+      if (_thread.joinable())
+      {
+        _thread.join();
+      }
+    }
+
+  private:
+    std::mutex _mutex{};
+    std::condition_variable _wake{};
+    bool _stop{false};
+    std::chrono::milliseconds _interval{};
+    std::thread _thread{};
+
+    void _run()
+    {
+      std::unique_lock lock{_mutex};
+      while (!_wake.wait_for(lock, _interval, [this] { return _stop; }))
+      {
+        lock.unlock();
+        log_summary();
+        {
+          Registry& zones = registry();
+          const std::scoped_lock zonesLock{zones.mutex};
+          for (Zone& zone : zones.zones)
+          {
+            zone.histogram.reset();
+          }
+        }
+        lock.lock();
+      }
+    }
+};
+
+SummaryThread& summary_thread()
+{
+  static SummaryThread thread{};
+  return thread;
+}
+
+double as_us(double ns)
+{
+  return ns / 1000.0; // NOLINT
+}
+
+double as_us(uint64_t ns)
+{
+  return as_us(static_cast<double>(ns));
+}
+} // namespace
+
+void Histogram::add(uint64_t value)
+{
+  _buckets[_bucket(value)].fetch_add(1, std::memory_order_relaxed);
+  _count.fetch_add(1, std::memory_order_relaxed);
+  _sum.fetch_add(value, std::memory_order_relaxed);
+
+  uint64_t max = _max.load(std::memory_order_relaxed);
+  while (value > max
+         && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+  {
+  }
+}
+
+uint64_t Histogram::percentile(double quantile) const
+{
+  uint64_t total{0};
+  for (const auto& bucket : _buckets)
+  {
+    total += bucket.load(std::memory_order_relaxed);
+  }
+
+  if (total == 0)
+  {
+    return 0;
+  }
+
+  const auto rank = std::max<uint64_t>(
+      static_cast<uint64_t>(std::ceil(std::clamp(quantile, 0.0, 1.0)
+                                      * static_cast<double>(total))),
+      1);
+
+  uint64_t seen{0};
+  for (size_t bucket = 0; bucket < numBuckets; ++bucket)
+  {
+    seen += _buckets[bucket].load(std::memory_order_relaxed);
+    if (seen >= rank)
+    {
+      // Middle of the bucket, never beyond the largest value seen
+      const uint64_t lower = _lowerBound(bucket);
+      const uint64_t upper = bucket + 1 < numBuckets ? _lowerBound(bucket + 1) : lower;
+      const uint64_t max   = _max.load(std::memory_order_relaxed);
+      return std::min(lower + (upper - lower) / 2, max);
+    }
+  }
+
+  return _max.load(std::memory_order_relaxed);
+}
+
+Histogram::Summary Histogram::summary() const
+{
+  const uint64_t count = _count.load(std::memory_order_relaxed);
+
+  return {
+      .count = count,
+      .mean  = count == 0 ? 0.0
+                          : static_cast<double>(_sum.load(std::memory_order_relaxed))
+                               / static_cast<double>(count),
+      .p50   = percentile(0.5),  // NOLINT
+      .p99   = percentile(0.99), // NOLINT
+      .max   = _max.load(std::memory_order_relaxed),
+  };
+}
+
+void Histogram::reset()
+{
+  for (auto& bucket : _buckets)
+  {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  _count.store(0, std::memory_order_relaxed);
+  _sum.store(0, std::memory_order_relaxed);
+  _max.store(0, std::memory_order_relaxed);
+}
+
+size_t Histogram::_bucket(uint64_t value)
+{
+  if (value < subBuckets)
+  {
+    return value;
+  }
+
+  // bit_width - 1, whose return type differs between libstdc++ versions
+  const size_t exponent = static_cast<size_t>(std::numeric_limits<uint64_t>::digits - 1)
+                        - static_cast<size_t>(std::countl_zero(value));
+  const size_t sub    = (value >> (exponent - subBits)) & (subBuckets - 1);
+  return (exponent - subBits + 1) * subBuckets + sub;
+}
+
+uint64_t Histogram::_lowerBound(size_t bucket)
+{
+  if (bucket < subBuckets)
+  {
+    return bucket;
+  }
+
+  const size_t exponent = bucket / subBuckets + subBits - 1;
+  const uint64_t sub    = bucket % subBuckets;
+  return (uint64_t{1} << exponent) | (sub << (exponent - subBits));
+}
+
+Zone& zone(std::string_view name)
+{
+  if constexpr (!compiled)
+  {
+    // Nothing records into it, no lock and no name to copy
+    static Zone disabled{};
+    return disabled;
+  }
+
+  Registry& zones = registry();
+  const std::scoped_lock lock{zones.mutex};
+
+  const auto found = std::ranges::find(zones.zones, name, &Zone::name);
+  if (found != zones.zones.end())
+  {
+    return *found;
+  }
+
+  return zones.zones.emplace_back(std::string{name});
+}
+
+std::vector<ZoneSummary> summary()
+{
+  Registry& zones = registry();
+  const std::scoped_lock lock{zones.mutex};
+
+  std::vector<ZoneSummary> summaries{};
+  for (const Zone& zone : zones.zones)
+  {
+    const Histogram::Summary summary = zone.histogram.summary();
+    if (summary.count != 0)
+    {
+      summaries.push_back({.name = zone.name, .summary = summary});
+    }
+  }
+  return summaries;
+}
+
+void log_summary()
+{
+  for (const auto& [name, zone] : summary())
+  {
+    logger::info("profile {:<28} {:>7} calls  mean {:>9.1f} us  p50 {:>9.1f} us  "
+                 "p99 {:>9.1f} us  max {:>9.1f} us",
+                 name,
+                 zone.count,
+                 as_us(zone.mean),
+                 as_us(zone.p50),
+                 as_us(zone.p99),
+                 as_us(zone.max));
+  }
+}
+
+void enable_summary(std::chrono::milliseconds interval)
+{
+  summary_thread().start(interval);
+}
+
+void disable_summary()
+{
+  summary_thread().stop();
+}
+} // namespace gfx::utils::profile
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Scopes compile to nothing with GFX_PROFILE=0 and every zone is one shared
+// zone, so looking one up neither locks nor allocates
+#ifndef GFX_PROFILE
+#define GFX_PROFILE 1
+#endif
+
+// Scoped timing of hot paths, e.g.
+//   static auto& zone = profile::zone("Quad::draw");
+//   const profile::Scope scope{zone};
+// Every zone keeps a histogram of its durations, 'summary' reads them all and
+// 'enable_summary' logs them periodically.
+namespace gfx::utils::profile
+{
+constexpr bool compiled{GFX_PROFILE != 0};
+
+// Log-linear buckets, 16 per power of two, values within 1/16 of the true one.
+// Recording is a handful of relaxed atomic adds, safe from any thread.
+class Histogram
+{
+  public:
+    struct Summary
+    {
+        uint64_t count{};
+        double mean{};
+        uint64_t p50{};
+        uint64_t p99{};
+        uint64_t max{};
+    };
+
+    void add(uint64_t value);
+
+    // 'quantile' in [0, 1]
+    [[nodiscard]] uint64_t percentile(double quantile) const;
+    [[nodiscard]] Summary summary() const;
+
+    // Concurrent adds may land on either side of the reset
+    void reset();
+
+  private:
+    static constexpr size_t subBits{4};
+    static constexpr size_t subBuckets{size_t{1} << subBits};
+    static constexpr size_t numBuckets{(64 - subBits + 1) * subBuckets};
+
+    static size_t _bucket(uint64_t value);
+    static uint64_t _lowerBound(size_t bucket);
+
+    std::array<std::atomic<uint64_t>, numBuckets> _buckets{};
+    std::atomic<uint64_t> _count{0};
+    std::atomic<uint64_t> _sum{0};
+    std::atomic<uint64_t> _max{0};
+};
+
+// Durations in nanoseconds
+struct Zone
+{
+    std::string name;
+    Histogram histogram{};
+};
+
+// The same name returns the same zone, references stay valid. Not registered
+// when profiling is compiled out.
+[[nodiscard]] Zone& zone(std::string_view name);
+
+class Scope
+{
+  public:
+    explicit Scope(Zone& zone)
+    {
+      if constexpr (compiled)
+      {
+        _zone  = &zone;
+        _start = std::chrono::steady_clock::now();
+      }
+    }
+
+    ~Scope()
+    {
+      if constexpr (compiled)
+      {
+        const auto elapsed = std::chrono::steady_clock::now() - _start;
+        _zone->histogram.add(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+      }
+    }
+
+    Scope(const Scope&)            = delete;
+    Scope& operator=(const Scope&) = delete;
+    Scope(Scope&&)                 = delete;
+    Scope& operator=(Scope&&)      = delete;
+
+  private:
+    Zone* _zone{nullptr};
+    std::chrono::steady_clock::time_point _start{};
+};
+
+struct ZoneSummary
+{
+    std::string name;
+    Histogram::Summary summary;
+};
+
+// Zones that recorded anything, in registration order
+[[nodiscard]] std::vector<ZoneSummary> summary();
+
+// Log every zone through the logger
+void log_summary();
+
+// Log the summary every 'interval' from a background thread and start the
+// histograms over, so each line covers one interval
+void enable_summary(std::chrono::milliseconds interval = std::chrono::seconds{5});
+void disable_summary();
+} // namespace gfx::utils::profile
@@ -0,0 +1,153 @@
+#include "thread_pool.hpp"
+
+#include "utils/logger.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace gfx::utils
+{
+namespace
+{
+thread_local const ThreadPool* t_pool{nullptr};
+thread_local size_t t_workerIndex{0};
+} // namespace
+
+ThreadPool::ThreadPool(size_t numThreads)
+{
+  numThreads = std::max<size_t>(numThreads, 1);
+
+  _queues.reserve(numThreads);
+  for (size_t index = 0; index < numThreads; ++index)
+  {
+    _queues.push_back(std::make_unique<Queue>());
+  }
+
+  _workers.reserve(numThreads);
+  for (size_t index = 0; index < numThreads; ++index)
+  {
+    _workers.emplace_back([this, index] { _run(index); });
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  wait();
+
+  {
+    const std::scoped_lock lock{_mutex};
+    _stop = true;
+  }
+  _wake.notify_all();
+
+  for (auto& worker : _workers)
+  {
+    worker.join();
+  }
+}
+
+void ThreadPool::submit(Task task)
+{
+  size_t index{};
+  {
+    const std::scoped_lock lock{_mutex};
+    index = (t_pool == this) ? t_workerIndex : _next++ % _queues.size();
+    ++_pending;
+    ++_queued;
+  }
+
+  {
+    auto& queue = *_queues[index];
+    const std::scoped_lock lock{queue.mutex};
+    queue.tasks.push_back(std::move(task));
+  }
+
+  _wake.notify_one();
+}
+
+void ThreadPool::wait()
+{
+  std::unique_lock lock{_mutex};
+  _idle.wait(lock, [this] { return _pending == 0; });
+}
+
+size_t ThreadPool::size() const
+{
+  return _workers.size();
+}
+
+bool ThreadPool::_pop(size_t index, Task& task)
+{
+  auto& queue = *_queues[index];
+  const std::scoped_lock lock{queue.mutex};
+  if (queue.tasks.empty())
+  {
+    return false;
+  }
+
+  task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  return true;
+}
+
+bool ThreadPool::_steal(size_t index, Task& task)
+{
+  for (size_t offset = 1; offset < _queues.size(); ++offset)
+  {
+    auto& queue = *_queues[(index + offset) % _queues.size()];
+    const std::scoped_lock lock{queue.mutex};
+    if (!queue.tasks.empty())
+    {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::_run(size_t index)
+{
+  t_pool        = this;
+  t_workerIndex = index;
+
+  while (true)
+  {
+    Task task{};
+    if (_pop(index, task) || _steal(index, task))
+    {
+      {
+        const std::scoped_lock lock{_mutex};
+        --_queued;
+      }
+
+      try
+      {
+        task();
+      }
+      catch (const std::exception& e)
+      {
+        logger::error("{}", e.what());
+      }
+
+      const std::scoped_lock lock{_mutex};
+      if (--_pending == 0)
+      {
+        _idle.notify_all();
+      }
+      continue;
+    }
+
+    std::unique_lock lock{_mutex};
+    _wake.wait(lock, [this] { return _stop || _queued > 0; });
+    if (_stop && _queued == 0)
+    {
+      return;
+    }
+  }
+}
+} // namespace gfx::utils
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gfx::utils
+{
+// Fixed size pool where every worker owns a task queue. Workers take their own
+// newest task first and steal the oldest task of another worker when idle.
+class ThreadPool
+{
+  public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t numThreads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&)                 = delete;
+    ThreadPool& operator=(ThreadPool&&)      = delete;
+
+    // Tasks submitted from a worker are queued on that worker
+    void submit(Task task);
+
+    // Block until every submitted task, including nested ones, has finished
+    void wait();
+
+    [[nodiscard]] size_t size() const;
+
+  private:
+    struct Queue
+    {
+        std::mutex mutex{};
+        std::deque<Task> tasks{};
+    };
+
+    std::vector<std::unique_ptr<Queue>> _queues{};
+    std::vector<std::thread> _workers{};
+
+    std::mutex _mutex{};
+    std::condition_variable _wake{};
+    std::condition_variable _idle{};
+    size_t _queued{0};
+    size_t _pending{0};
+    size_t _next{0};
+    bool _stop{false};
+
+    bool _pop(size_t index, Task& task);
+    bool _steal(size_t index, Task& task);
+    void _run(size_t index);
+};
+} // namespace gfx::utils
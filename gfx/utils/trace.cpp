@@ -0,0 +1,350 @@
+#include "trace.hpp"
+
+#include "utils/logger.hpp"
+
+#include <fmt/core.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gfx::utils::trace
+{
+namespace
+{
+constexpr std::array<char, 8> magic{'G', 'F', 'X', 'T', 'R', 'A', 'C', 'E'};
+constexpr uint32_t version{1};
+constexpr size_t maxEvents{256};
+constexpr size_t nameSize{56};
+
+// Records a thread claims at once, the only shared write while tracing
+constexpr size_t chunkRecords{1024};
+
+struct Header
+{
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t capacity;
+    uint32_t pid;
+    uint32_t numEvents;
+    std::array<std::array<char, nameSize>, maxEvents> names;
+};
+
+static_assert(sizeof(Header) % alignof(Record) == 0);
+
+struct State
+{
+    std::mutex mutex{};
+    std::vector<std::string> names{std::string{}};
+
+    int fd{-1};
+    void* mapping{nullptr};
+    size_t mappingSize{};
+    Header* header{nullptr};
+    Record* records{nullptr};
+    size_t capacity{};
+    std::chrono::steady_clock::time_point start{};
+
+    std::atomic<size_t> nextChunk{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> generation{0};
+};
+
+State& state()
+{
+  static State instance{};
+  return instance;
+}
+
+// Chunk of the current trace owned by this thread
+struct LocalChunk
+{
+    uint64_t generation{~uint64_t{0}};
+    Record* cursor{nullptr};
+    Record* end{nullptr};
+    uint32_t thread{};
+};
+
+thread_local LocalChunk t_chunk{};
+
+void write_name(Header& header, EventId event, std::string_view name)
+{
+  auto& slot = header.names.at(event);
+  slot.fill('\0');
+  std::copy_n(name.begin(), std::min(name.size(), nameSize - 1), slot.begin());
+  header.numEvents = std::max<uint32_t>(header.numEvents, event + 1U);
+}
+
+void unmap(State& trace)
+{
+  const size_t used = std::min(trace.nextChunk.load() * chunkRecords, trace.capacity);
+
+  msync(trace.mapping, trace.mappingSize, MS_SYNC);
+  munmap(trace.mapping, trace.mappingSize);
+
+  // Drop the never claimed tail, partially filled chunks keep empty slots
+  if (ftruncate(trace.fd, static_cast<off_t>(sizeof(Header) + used * sizeof(Record)))
+      != 0)
+  {
+    logger::warning("gfx::trace - could not truncate trace file");
+  }
+  ::close(trace.fd);
+
+  trace.fd      = -1;
+  trace.mapping = nullptr;
+  trace.header  = nullptr;
+  trace.records = nullptr;
+}
+
+std::string escape(std::string_view name)
+{
+  std::string escaped{};
+  for (const char character : name)
+  {
+    if (character == '"' || character == '\\')
+    {
+      escaped += '\\';
+    }
+    escaped += character;
+  }
+  return escaped;
+}
+
+char phase_code(Phase phase)
+{
+  switch (phase)
+  {
+    case Phase::Begin:
+      return 'B';
+    case Phase::End:
+      return 'E';
+    case Phase::Instant:
+      break;
+  }
+  return 'i';
+}
+} // namespace
+
+namespace detail
+{
+void record(EventId event, Phase phase, uint64_t value)
+{
+  if (event == 0)
+  {
+    return;
+  }
+
+  auto& trace = state();
+  auto& chunk = t_chunk;
+
+  const uint64_t generation = trace.generation.load(std::memory_order_acquire);
+  if (chunk.generation != generation)
+  {
+    chunk = LocalChunk{
+        .generation = generation,
+        .thread     = static_cast<uint32_t>(syscall(SYS_gettid)),
+    };
+  }
+
+  if (chunk.cursor == chunk.end)
+  {
+    const size_t first = trace.nextChunk.fetch_add(1, std::memory_order_relaxed)
+                       * chunkRecords;
+    if (first >= trace.capacity)
+    {
+      trace.dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    chunk.cursor = std::next(trace.records, static_cast<ptrdiff_t>(first));
+    chunk.end    = std::next(trace.records,
+                          static_cast<ptrdiff_t>(
+                              std::min(first + chunkRecords, trace.capacity)));
+  }
+
+  const auto elapsed = std::chrono::steady_clock::now() - trace.start;
+
+  *chunk.cursor = Record{
+      .timestamp = static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+      .value     = value,
+      .thread    = chunk.thread,
+      .event     = event,
+      .phase     = phase,
+      .reserved  = 0,
+  };
+  chunk.cursor = std::next(chunk.cursor);
+}
+} // namespace detail
+
+// NOLINTNEXTLINE(readability-function-size)
+void open(const std::filesystem::path& path, size_t capacity)
+{
+  auto& trace = state();
+  const std::scoped_lock lock{trace.mutex};
+
+  detail::g_enabled = false;
+  if (trace.mapping != nullptr)
+  {
+    unmap(trace);
+  }
+
+  const size_t mappingSize = sizeof(Header) + capacity * sizeof(Record);
+
+  const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644); // NOLINT
+  if (fd < 0)
+  {
+    throw std::runtime_error(
+        fmt::format("gfx::trace - could not open '{}'", path.string()));
+  }
+
+  if (ftruncate(fd, static_cast<off_t>(mappingSize)) != 0)
+  {
+    ::close(fd);
+    throw std::runtime_error("gfx::trace - could not size trace file");
+  }
+
+  void* mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (mapping == MAP_FAILED) // NOLINT
+  {
+    ::close(fd);
+    throw std::runtime_error("gfx::trace - could not map trace file");
+  }
+
+  trace.fd          = fd;
+  trace.mapping     = mapping;
+  trace.mappingSize = mappingSize;
+  trace.capacity    = capacity;
+  trace.header      = static_cast<Header*>(mapping);
+  trace.records     = reinterpret_cast<Record*>(std::next(trace.header)); // NOLINT
+
+  trace.header->magic      = magic;
+  trace.header->version    = version;
+  trace.header->recordSize = sizeof(Record);
+  trace.header->capacity   = capacity;
+  trace.header->pid        = static_cast<uint32_t>(getpid());
+  trace.header->numEvents  = 0;
+
+  for (size_t index = 1; index < trace.names.size(); ++index)
+  {
+    write_name(*trace.header, static_cast<EventId>(index), trace.names[index]);
+  }
+
+  trace.nextChunk = 0;
+  trace.dropped   = 0;
+  trace.start     = std::chrono::steady_clock::now();
+  trace.generation.fetch_add(1, std::memory_order_release);
+
+  detail::g_enabled = true;
+}
+
+void close()
+{
+  auto& trace = state();
+  const std::scoped_lock lock{trace.mutex};
+
+  detail::g_enabled = false;
+  if (trace.mapping != nullptr)
+  {
+    unmap(trace);
+  }
+  trace.generation.fetch_add(1, std::memory_order_release);
+}
+
+uint64_t dropped()
+{
+  return state().dropped.load(std::memory_order_relaxed);
+}
+
+EventId event(std::string_view name)
+{
+  auto& trace = state();
+  const std::scoped_lock lock{trace.mutex};
+
+  const auto found = std::find(std::next(trace.names.begin()), trace.names.end(), name);
+  if (found != trace.names.end())
+  {
+    return static_cast<EventId>(std::distance(trace.names.begin(), found));
+  }
+
+  if (trace.names.size() == maxEvents)
+  {
+    logger::warning("gfx::trace - event limit reached, '{}' is not recorded", name);
+    return 0;
+  }
+
+  const auto event = static_cast<EventId>(trace.names.size());
+  trace.names.emplace_back(name);
+
+  if (trace.header != nullptr)
+  {
+    write_name(*trace.header, event, name);
+  }
+  return event;
+}
+
+// NOLINTNEXTLINE(readability-function-size)
+size_t to_chrome_json(const std::filesystem::path& path, std::ostream& output)
+{
+  std::ifstream input{path, std::ios::binary};
+
+  Header header{};
+  input.read(reinterpret_cast<char*>(&header), sizeof(Header)); // NOLINT
+  if (!input || header.magic != magic || header.version != version
+      || header.recordSize != sizeof(Record))
+  {
+    throw std::runtime_error(
+        fmt::format("gfx::trace - '{}' is not a trace file", path.string()));
+  }
+
+  std::vector<Record> records{};
+  Record record{};
+  while (input.read(reinterpret_cast<char*>(&record), sizeof(Record))) // NOLINT
+  {
+    if (record.event != 0 && record.event < header.numEvents)
+    {
+      records.push_back(record);
+    }
+  }
+
+  std::ranges::stable_sort(records, {}, &Record::timestamp);
+
+  output << R"({"displayTimeUnit":"ms","traceEvents":[)";
+  for (size_t index = 0; index < records.size(); ++index)
+  {
+    const Record& event = records[index];
+    const std::string_view name{header.names.at(event.event).data()};
+
+    output << fmt::format(
+        R"({}{{"name":"{}","ph":"{}","ts":{:.3f},)"
+        R"("pid":{},"tid":{},"args":{{"value":{}}}{}}})",
+        index == 0 ? "" : ",\n",
+        escape(name),
+        phase_code(event.phase),
+        static_cast<double>(event.timestamp) / 1000.0, // NOLINT
+        header.pid,
+        event.thread,
+        event.value,
+        event.phase == Phase::Instant ? R"(,"s":"t")" : "");
+  }
+  output << "]}\n";
+
+  return records.size();
+}
+} // namespace gfx::utils::trace
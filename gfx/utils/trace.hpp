@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <optional>
+#include <string_view>
+
+// Binary frame event trace written through a memory mapped file. Every thread
+// fills its own chunk of fixed size records, nothing is formatted while tracing.
+// Convert a finished trace with 'trace-to-json' and open it in chrome://tracing
+// or ui.perfetto.dev.
+namespace gfx::utils::trace
+{
+using EventId = uint16_t;
+
+enum class Phase : uint8_t
+{
+  Begin,
+  End,
+  Instant
+};
+
+struct Record
+{
+    uint64_t timestamp; // ns since trace::open
+    uint64_t value;     // e.g. frame index
+    uint32_t thread;
+    EventId event;      // 0 marks an unused slot
+    Phase phase;
+    uint8_t reserved;
+};
+
+static_assert(sizeof(Record) == 24);
+
+namespace detail
+{
+inline std::atomic<bool> g_enabled{false};
+
+void record(EventId event, Phase phase, uint64_t value);
+} // namespace detail
+
+// Records until close, events beyond 'capacity' are dropped and counted
+void open(const std::filesystem::path& path, size_t capacity = size_t{1} << 20U);
+
+// Threads must not record while the trace closes
+void close();
+
+[[nodiscard]] uint64_t dropped();
+
+// Register once, e.g. 'static const auto decoded = trace::event("decoded")'
+[[nodiscard]] EventId event(std::string_view name);
+
+[[nodiscard]] inline bool enabled()
+{
+  return detail::g_enabled.load(std::memory_order_relaxed);
+}
+
+inline void begin(EventId event, uint64_t value = 0)
+{
+  if (enabled()) [[unlikely]]
+  {
+    detail::record(event, Phase::Begin, value);
+  }
+}
+
+inline void end(EventId event, uint64_t value = 0)
+{
+  if (enabled()) [[unlikely]]
+  {
+    detail::record(event, Phase::End, value);
+  }
+}
+
+inline void instant(EventId event, uint64_t value = 0)
+{
+  if (enabled()) [[unlikely]]
+  {
+    detail::record(event, Phase::Instant, value);
+  }
+}
+
+class Scope
+{
+  public:
+    explicit Scope(EventId event, uint64_t value = 0)
+        : _event{event}
+    {
+      begin(_event, value);
+    }
+
+    ~Scope()
+    {
+      end(_event);
+    }
+
+    Scope(const Scope&)            = delete;
+    Scope& operator=(const Scope&) = delete;
+    Scope(Scope&&)                 = delete;
+    Scope& operator=(Scope&&)      = delete;
+
+  private:
+    EventId _event;
+};
+
+// Traces from construction to destruction when 'path' is given, e.g. '--trace'.
+// Outlive every thread that records.
+class Session
+{
+  public:
+    explicit Session(const std::optional<std::filesystem::path>& path)
+        : _open{path.has_value()}
+    {
+      if (_open)
+      {
+        open(*path);
+      }
+    }
+
+    ~Session()
+    {
+      if (_open)
+      {
+        close();
+      }
+    }
+
+    Session(const Session&)            = delete;
+    Session& operator=(const Session&) = delete;
+    Session(Session&&)                 = delete;
+    Session& operator=(Session&&)      = delete;
+
+  private:
+    bool _open;
+};
+
+// Write a trace file as Chrome trace event JSON, returns the number of events
+size_t to_chrome_json(const std::filesystem::path& path, std::ostream& output);
+} // namespace gfx::utils::trace
@@ -0,0 +1,32 @@
+#include "arg_parser.hpp"
+#include "logger.hpp"
+#include "trace.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+
+// Convert a binary trace from '--input-path' to Chrome trace JSON in '--output-path'
+int main(int argc, const char* const* argv)
+{
+  try
+  {
+    const gfx::utils::ArgParser argParser{argc, argv};
+    std::ofstream output{argParser.getOutputPath()};
+
+    const size_t numEvents = gfx::utils::trace::to_chrome_json(argParser.getInputPath(),
+                                                               output);
+
+    gfx::utils::logger::info("wrote {} events to {}",
+                             numEvents,
+                             argParser.getOutputPath().string());
+  }
+  catch (const std::exception& e)
+  {
+    std::puts(e.what());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
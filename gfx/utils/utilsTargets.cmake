@@ -8,20 +8,75 @@ target_include_directories(arg_parser PRIVATE ${CMAKE_CURRENT_LIST_DIR}/../)
 
 add_library(utils_logger STATIC)
 
-target_sources(utils_logger PRIVATE ${CMAKE_CURRENT_LIST_DIR}/logger.cpp)
+target_sources(
+  utils_logger
+  PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/logger.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/call_site.cpp
+)
 
 target_include_directories(utils_logger PRIVATE ${CMAKE_CURRENT_LIST_DIR}/../)
 
+target_link_libraries(utils_logger fmt::fmt pthread)
+
+add_library(thread_pool STATIC)
+
+target_sources(thread_pool PRIVATE ${CMAKE_CURRENT_LIST_DIR}/thread_pool.cpp)
+
+target_include_directories(thread_pool PRIVATE ${CMAKE_CURRENT_LIST_DIR}/../)
+
+target_link_libraries(thread_pool pthread)
+
+add_library(trace STATIC)
+
+target_sources(trace PRIVATE ${CMAKE_CURRENT_LIST_DIR}/trace.cpp)
+
+target_include_directories(trace PRIVATE ${CMAKE_CURRENT_LIST_DIR}/../)
+
+target_link_libraries(trace fmt::fmt)
+
+add_library(profile STATIC)
+
+target_sources(profile PRIVATE ${CMAKE_CURRENT_LIST_DIR}/profile.cpp)
+
+target_include_directories(profile PRIVATE ${CMAKE_CURRENT_LIST_DIR}/../)
+
+target_link_libraries(profile fmt::fmt pthread utils::logger)
+
+add_library(image_sink STATIC)
+
+target_sources(image_sink PRIVATE ${CMAKE_CURRENT_LIST_DIR}/image_sink.cpp)
+
+target_include_directories(image_sink PRIVATE ${CMAKE_CURRENT_LIST_DIR}/../)
+
+target_link_libraries(
+  image_sink
+  stb_image_implementation
+  fmt::fmt
+  vocabulary
+  thread_pool
+  utils::logger
+)
+
+add_executable(trace-to-json ${CMAKE_CURRENT_LIST_DIR}/trace_to_json_main.cpp)
+
+target_link_libraries(trace-to-json trace arg_parser utils_logger)
+
 add_library(utils_logger_stub STATIC)
 
 target_sources(
-  utils_logger_stub PRIVATE ${CMAKE_CURRENT_LIST_DIR}/logger_stub.cpp
+  utils_logger_stub
+  PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/logger_stub.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/call_site.cpp
 )
 
 target_include_directories(
   utils_logger_stub PRIVATE ${CMAKE_CURRENT_LIST_DIR}/../
 )
 
+target_link_libraries(utils_logger_stub fmt::fmt)
+
 add_library(json_parser STATIC)
 
 target_sources(json_parser PRIVATE ${CMAKE_CURRENT_LIST_DIR}/json_parser.cpp)
@@ -38,20 +93,40 @@ target_link_libraries(
   app_utils_demuxer_c ffmpeg::libavcodec ffmpeg::libavformat
 )
 
-add_executable(app_utils_demuxer_cpp ${CMAKE_CURRENT_LIST_DIR}/demuxer.cpp)
+add_library(
+  video_demuxer STATIC ${CMAKE_CURRENT_LIST_DIR}/demuxer.cpp
+                       ${CMAKE_CURRENT_LIST_DIR}/converter.cpp
+)
 
-ignore_gfx_target(app_utils_demuxer_cpp CLANG_TIDY)
+ignore_gfx_target(video_demuxer CLANG_TIDY)
 
 target_link_libraries(
-  app_utils_demuxer_cpp
+  video_demuxer
   ffmpeg::libavcodec
   ffmpeg::libavformat
+  ffmpeg::libswscale
   fmt::fmt
+  vocabulary
+  vocabulary::uri
+  utils::logger
+  utils::profile
+  utils::trace
 )
 
+add_executable(
+  app_utils_demuxer_cpp ${CMAKE_CURRENT_LIST_DIR}/demuxer_main.cpp
+)
+
+target_link_libraries(app_utils_demuxer_cpp video_demuxer fmt::fmt)
+
 add_library(utils::logger ALIAS utils_logger)
+add_library(utils::video_demuxer ALIAS video_demuxer)
 add_library(stubs::utils::logger ALIAS utils_logger_stub)
 add_library(utils::arg_parser ALIAS arg_parser)
+add_library(utils::thread_pool ALIAS thread_pool)
+add_library(utils::trace ALIAS trace)
+add_library(utils::profile ALIAS profile)
+add_library(utils::image_sink ALIAS image_sink)
 add_library(utils::json_parser ALIAS json_parser)
 
 add_executable(pip-output-parser gfx/utils/pip_output_parser_main.cpp)
@@ -28,7 +28,7 @@ URI::Schema getSchema(std::string_view uri)
   }
   else
   {
-    utils::logger::fatal("invalid schema in uri: ", uri);
+    utils::logger::fatal("invalid schema in uri: {}", uri);
   }
   return result;
 }
@@ -153,23 +153,23 @@ debugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
 {
   if (messageSeverity == VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)
   {
-    utils::logger::error(pCallbackData->pMessage);
+    utils::logger::error("{}", pCallbackData->pMessage);
     // throw std::runtime_error(std::string{"gfx::ERROR::"} + pCallbackData->pMessage);
   }
 
   if (messageSeverity == VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT)
   {
-    utils::logger::warning(pCallbackData->pMessage);
+    utils::logger::warning("{}", pCallbackData->pMessage);
   }
 
   if (messageSeverity == VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT)
   {
-    utils::logger::info(pCallbackData->pMessage);
+    utils::logger::info("{}", pCallbackData->pMessage);
   }
 
   if (messageSeverity == VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT)
   {
-    // utils::logger::info(pCallbackData->pMessage);
+    // utils::logger::info("{}", pCallbackData->pMessage);
   }
   return VK_FALSE;
 }
@@ -15,7 +15,7 @@ int main()
   }
   catch (const std::exception& e)
   {
-    gfx::utils::logger::error(e.what());
+    gfx::utils::logger::error("{}", e.what());
     return EXIT_FAILURE;
   }
 